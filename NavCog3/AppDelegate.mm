@@ -32,6 +32,8 @@
 #import <AVFoundation/AVFoundation.h>
 #import "ScreenshotHelper.h"
 #import "NavUtil.h"
+#import "InitViewController.h"
+#import <sys/resource.h>
 
 @import HLPDialog;
 
@@ -59,6 +61,20 @@ void NavNSLog(NSString* fmt, ...) {
     CBCentralManager *bluetoothManager;
     BOOL secondOrLater;
     NSTimeInterval lastActiveTime;
+    
+    // parameter sweep over a replayed log
+    NSString *sweepLogPath;
+    NSArray<NSDictionary*> *sweepParams;
+    NSMutableArray *sweepResults;
+    NSInteger sweepIndex;
+    id sweepObserver;
+    HLPLocation *sweepLastLocation;
+    long sweepUpdates;
+    long sweepMarkers;
+    double sweepErrorSum;
+    double sweepErrorMax;
+    long sweepFloorErrors;
+    double sweepCPUStart;
 }
 
 - (BOOL)application:(UIApplication *)application willFinishLaunchingWithOptions:(NSDictionary *)launchOptions
@@ -268,6 +284,26 @@ void uncaughtExceptionHandler(NSException *exception)
 }
 
 - (void) requestLogReplay:(NSNotification*) note
+{
+    // "<log>.sweep.json" (an array of setting overrides) next to the log runs a parameter sweep
+    NSString *path = note.userInfo[@"path"];
+    NSString *sweepPath = [[path stringByDeletingPathExtension] stringByAppendingPathExtension:@"sweep.json"];
+    NSData *sweepData = sweepParams ? nil : [NSData dataWithContentsOfFile:sweepPath];
+    if (sweepData) {
+        NSArray *params = [NSJSONSerialization JSONObjectWithData:sweepData options:0 error:nil];
+        if ([params isKindOfClass:NSArray.class] && params.count > 0) {
+            sweepLogPath = path;
+            sweepParams = params;
+            sweepResults = [@[] mutableCopy];
+            sweepIndex = 0;
+            [self startSweepStep];
+            return;
+        }
+    }
+    [self startLogReplay:path];
+}
+
+- (void) startLogReplay:(NSString*)path
 {
     NSUserDefaults *ud = [NSUserDefaults standardUserDefaults];
     NSDictionary *option =
@@ -278,7 +314,7 @@ void uncaughtExceptionHandler(NSException *exception)
       @"replay_with_reset": [ud valueForKey:@"replay_with_reset"],
       };
     BOOL bNavigation = [[NSUserDefaults standardUserDefaults] boolForKey:@"replay_navigation"];
-    [[HLPLocationManager sharedManager] startLogReplay:note.userInfo[@"path"] withOption:option withLogHandler:^(NSString *line) {
+    [[HLPLocationManager sharedManager] startLogReplay:path withOption:option withLogHandler:^(NSString *line) {
         if (bNavigation) {
             NSArray *v = [line componentsSeparatedByString:@" "];
             if (v.count > 3 && [v[3] hasPrefix:@"initTarget"]) {
@@ -296,13 +332,112 @@ void uncaughtExceptionHandler(NSException *exception)
 }
 
 - (void)requestLogReplayStop:(NSNotification*) note {
+    if (sweepParams) {
+        [self finishSweep];
+    }
     [[HLPLocationManager sharedManager] stopLogReplay];
 }
 
+#pragma mark - parameter sweep
+
+static double processCPUTime()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+- (void) startSweepStep
+{
+    NSDictionary *overrides = sweepParams[sweepIndex];
+    [[HLPLocationManager sharedManager] setParameters:[InitViewController locationManagerParamsWithOverrides:overrides]];
+    
+    sweepLastLocation = nil;
+    sweepUpdates = sweepMarkers = sweepFloorErrors = 0;
+    sweepErrorSum = sweepErrorMax = 0;
+    sweepCPUStart = processCPUTime();
+    [Logging traceReset];
+    
+    // markers in the log are the ground truth, compare them with the latest estimate
+    // the sweep state is only touched on the main queue
+    sweepObserver = [[NSNotificationCenter defaultCenter] addObserverForName:LOG_REPLAY_PROGRESS object:nil queue:[NSOperationQueue mainQueue] usingBlock:^(NSNotification * _Nonnull note) {
+        if (!sweepObserver) {
+            return;
+        }
+        NSDictionary *marker = note.userInfo[@"marker"];
+        if (marker[@"lat"] && marker[@"lng"] && sweepLastLocation) {
+            HLPLocation *truth = [[HLPLocation alloc] initWithLat:[marker[@"lat"] doubleValue] Lng:[marker[@"lng"] doubleValue] Floor:[marker[@"floor"] doubleValue]];
+            double error = [sweepLastLocation distanceTo:truth];
+            sweepErrorSum += error;
+            sweepErrorMax = MAX(sweepErrorMax, error);
+            sweepFloorErrors += (round(sweepLastLocation.floor) != round(truth.floor)) ? 1 : 0;
+            sweepMarkers++;
+        }
+        if ([note.userInfo[@"progress"] longValue] == [note.userInfo[@"total"] longValue]) {
+            // stop counting here so late notifications do not leak into the next step
+            [[NSNotificationCenter defaultCenter] removeObserver:sweepObserver];
+            sweepObserver = nil;
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self endSweepStep];
+            });
+        }
+    }];
+    [self startLogReplay:sweepLogPath];
+}
+
+- (void) endSweepStep
+{
+    if (!sweepParams) {
+        return;
+    }
+    [[NSNotificationCenter defaultCenter] removeObserver:sweepObserver];
+    sweepObserver = nil;
+    
+    double cpu = processCPUTime() - sweepCPUStart;
+    [sweepResults addObject:@{
+                              @"params": sweepParams[sweepIndex],
+                              @"updates": @(sweepUpdates),
+                              @"cpu_ms_per_update": @(sweepUpdates > 0 ? cpu * 1000 / sweepUpdates : 0),
+                              @"markers": @(sweepMarkers),
+                              @"mean_error": @(sweepMarkers > 0 ? sweepErrorSum / sweepMarkers : 0),
+                              @"max_error": @(sweepErrorMax),
+                              @"floor_errors": @(sweepFloorErrors),
+                              @"latency_ms": [Logging traceReport]
+                              }];
+    NSLog(@"Sweep,%ld/%ld,%@", sweepIndex+1, sweepParams.count, sweepResults.lastObject);
+    
+    sweepIndex++;
+    if (sweepIndex < sweepParams.count) {
+        [self startSweepStep];
+    } else {
+        [self finishSweep];
+    }
+}
+
+- (void) finishSweep
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:sweepObserver];
+    sweepObserver = nil;
+    
+    NSString *resultPath = [[sweepLogPath stringByDeletingPathExtension] stringByAppendingPathExtension:@"sweep_result.json"];
+    NSData *data = [NSJSONSerialization dataWithJSONObject:sweepResults options:NSJSONWritingPrettyPrinted error:nil];
+    [data writeToFile:resultPath atomically:YES];
+    
+    sweepParams = nil;
+    sweepResults = nil;
+    [[HLPLocationManager sharedManager] setParameters:[InitViewController locationManagerParamsWithOverrides:nil]];
+}
+
 #pragma mark - HLPLocationManagerDelegate
 
 - (void)locationManager:(HLPLocationManager *)manager didLocationUpdate:(HLPLocation *)location
 {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (sweepParams) {
+            sweepLastLocation = location;
+            sweepUpdates++;
+        }
+    });
     NSMutableDictionary *data =
     [@{
        //@"x": @(refPose.x()),
@@ -321,6 +456,7 @@ void uncaughtExceptionHandler(NSException *exception)
        //},
        //@"rotate":anchor[@"rotate"]
        } mutableCopy];
+    data[@"trace"] = @([Logging traceBegin:@"location"]);
     
     [[NSNotificationCenter defaultCenter] postNotificationName:LOCATION_CHANGED_NOTIFICATION object:self userInfo:data];
 }
@@ -38,6 +38,7 @@
     UISearchController *searchController;
     
     NSString *lastSearchQuery;
+    HLPDirectory *searchDirectory;
 }
 
 - (void)updateSearchResultsForSearchController:(UISearchController *)searchController
@@ -45,11 +46,23 @@
     NSString *query = searchController.searchBar.text;
     if (query && query.length > 0) {
         lastSearchQuery = query;
-        searchController.dimsBackgroundDuringPresentation = YES;
+        // show matches in the displayed directory while the server query is running
+        HLPDirectory *local = [searchDirectory search:query];
+        if (local.sections.count > 0) {
+            _source = [[NavDirectoryDataSource alloc] initWithDirectory:local];
+            searchController.dimsBackgroundDuringPresentation = NO;
+            [self.tableView reloadData];
+        } else {
+            searchController.dimsBackgroundDuringPresentation = YES;
+        }
         [[NavDataStore sharedDataStore] searchDestinations:query withComplete:^(HLPDirectory *directory) {
             if (![lastSearchQuery isEqualToString:query]) {
                 return;
             }
+            if (!directory && local.sections.count > 0) {
+                // keep the local matches if the server could not answer
+                return;
+            }
             dispatch_async(dispatch_get_main_queue(), ^{
                 _source = [[NavDirectoryDataSource alloc] initWithDirectory:directory];
                 searchController.dimsBackgroundDuringPresentation = NO;
@@ -68,9 +81,9 @@
     if ([[NavDataStore sharedDataStore] directory]) {
         NavDirectoryDataSource *source = [[NavDirectoryDataSource alloc] init];
         if (filterDest) {
-            source.directory = filterDest.item.content;
+            source.directory = searchDirectory = filterDest.item.content;
         } else {
-            source.directory = [[NavDataStore sharedDataStore] directory];
+            source.directory = searchDirectory = [[NavDataStore sharedDataStore] directory];
             
             if ([self.restorationIdentifier isEqualToString:@"fromDestinations"]) {
                 self.navigationItem.title = NSLocalizedStringFromTable(@"_nav_select_start", @"BlindView", @"");
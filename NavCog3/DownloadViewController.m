@@ -81,17 +81,24 @@
 - (void)URLSession:(NSURLSession *)session downloadTask:(NSURLSessionDownloadTask *)downloadTask
 didFinishDownloadingToURL:(NSURL *)location
 {
-    NSError *error = nil;
-    
-    NSURL *destLocation = [[ServerConfig sharedConfig] getDestLocation:downloadTask.originalRequest.URL.path];
-    [[NSFileManager defaultManager] removeItemAtURL:destLocation error:nil];
-    NSLog(@"moving %@ to %@", location.path, destLocation.path);
-    [[NSFileManager defaultManager] moveItemAtURL:location toURL:destLocation error:&error];
-    if (error) {
-        NSLog(@"error=%@", error);
+    NSDictionary *file = [downloadingFiles firstObject];
+    NSDictionary *fallback = nil;
+    if (![[ServerConfig sharedConfig] installDownloadedFile:location forEntry:file]) {
+        fallback = file[@"fallback"];
+        if (!fallback) {
+            // the whole file could not be installed, do not go on as if it were
+            NSLog(@"could not install %@", file[@"url"]);
+            [self downloadFailed];
+            return;
+        }
     }
     
     downloadingFiles = [downloadingFiles subarrayWithRange:NSMakeRange(1, [downloadingFiles count]-1)];
+    if (fallback) {
+        // patch could not be applied, download the whole file
+        totalLength += [fallback[@"length"] longValue];
+        downloadingFiles = [@[fallback] arrayByAddingObjectsFromArray:downloadingFiles];
+    }
     [self downloadNext];
 }
 
@@ -134,6 +141,31 @@ expectedTotalBytes:(int64_t)expectedTotalBytes
     [task resume];
 }
 
+- (void) downloadFailed
+{
+    [session invalidateAndCancel];
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        UIAlertController *alert = [UIAlertController alertControllerWithTitle:NSLocalizedString(@"DOWNLOAD_FAILED", @"")
+                                                                       message:NSLocalizedString(@"DOWNLOAD_FAILED_MESSAGE", @"")
+                                                                preferredStyle:UIAlertControllerStyleAlert];
+        [alert addAction:[UIAlertAction actionWithTitle:NSLocalizedString(@"RETRY", @"")
+                                                  style:UIAlertActionStyleDefault handler:^(UIAlertAction *action) {
+                                                      // installed files are in the manifest, only the rest is downloaded again
+                                                      self.progressBar.progress = 0;
+                                                      self.progressLabel.text = @"0%";
+                                                      [self downloadFiles:[[ServerConfig sharedConfig] checkDownloadFiles]];
+                                                  }]];
+        [alert addAction:[UIAlertAction actionWithTitle:NSLocalizedString(@"CANCEL", @"")
+                                                  style:UIAlertActionStyleCancel handler:^(UIAlertAction *action) {
+                                                      // back to the server selection
+                                                      [[ServerConfig sharedConfig] clear];
+                                                      [self performSegueWithIdentifier:@"unwind_download" sender:self];
+                                                  }]];
+        [self presentViewController:alert animated:YES completion:nil];
+    });
+}
+
 - (void)updateProgress
 {
     //NSLog(@"downloadedLength=%ld", downloadedLength);
@@ -27,4 +27,6 @@
 
 @property (weak, nonatomic) IBOutlet UITableView *tableView;
 
++ (NSDictionary*) locationManagerParamsWithOverrides:(NSDictionary*)overrides;
+
 @end
@@ -176,7 +176,7 @@
         [manager setModelPath:modelPath];
     }
     
-    NSDictionary *params = [self getLocationManagerParams];
+    NSDictionary *params = [InitViewController locationManagerParamsWithOverrides:nil];
     [manager setParameters:params];
     
     [manager start];
@@ -188,7 +188,9 @@
     }
 }
 
-- (NSDictionary*) getLocationManagerParams
+// maps the settings (NSUserDefaults keys) into HLPLocationManager parameters,
+// overrides replace settings so that other parameter sets can be mapped
++ (NSDictionary*) locationManagerParamsWithOverrides:(NSDictionary*)overrides
 {
     NSMutableDictionary *params = [@{} mutableCopy];
     
@@ -246,14 +248,17 @@
       @"use_compass":       @"usesCompass",
       };
     
-    NSUserDefaults *ud = [NSUserDefaults standardUserDefaults];
+    NSMutableDictionary *ud = [[[NSUserDefaults standardUserDefaults] dictionaryRepresentation] mutableCopy];
+    if (overrides) {
+        [ud addEntriesFromDictionary:overrides];
+    }
     
     [nameTable enumerateKeysAndObjectsUsingBlock:^(NSString *from, NSString *to, BOOL * _Nonnull stop) {
         
         NSObject *value;
         
         if ([from isEqualToString:@"location_tracking"]) {
-            NSString *location_tracking = [ud stringForKey:from];
+            NSString *location_tracking = ud[from];
             if ([location_tracking isEqualToString:@"tracking"]) {
                 value = @(HLPRandomWalkAccAtt);
             } else if([location_tracking isEqualToString:@"oneshot"]) {
@@ -265,9 +270,9 @@
             }
         }
         else if ([from isEqualToString:@"activatesStatusMonitoring"]) {
-            bool activatesDynamicStatusMonitoring = [ud boolForKey:@"activatesStatusMonitoring"];
+            bool activatesDynamicStatusMonitoring = [ud[@"activatesStatusMonitoring"] boolValue];
             if(activatesDynamicStatusMonitoring){
-                double minWeightStable = pow(10.0, [ud doubleForKey:@"exponentMinWeightStable"]);
+                double minWeightStable = pow(10.0, [ud[@"exponentMinWeightStable"] doubleValue]);
                 params[@"locationStatusMonitorParameters.minimumWeightStable"] = @(minWeightStable);
                 params[@"locationStatusMonitorParameters.stdev2DEnterStable"] = ([ud valueForKey:@"enterStable"]);
                 params[@"locationStatusMonitorParameters.stdev2DExitStable"] = ([ud valueForKey:@"exitStable"]);
@@ -287,7 +292,7 @@
             return;
         }
         else if ([from isEqualToString:@"wheelchair_pdr"]) {
-            value = @([ud boolForKey:@"wheelchair_pdr"]?0.1:0.6);
+            value = @([ud[@"wheelchair_pdr"] boolValue]?0.1:0.6);
         }
         else if ([from isEqualToString:@"locLB"]) {
             value = [ud valueForKey:@"locLB"];
@@ -296,14 +301,14 @@
             return;
         }
         else if ([from isEqualToString:@"rssi_bias"]) {
-            double rssiBias = [ud doubleForKey:@"rssi_bias"];
-            if([ud boolForKey:@"rssi_bias_model_used"]){
+            double rssiBias = [ud[@"rssi_bias"] doubleValue];
+            if([ud[@"rssi_bias_model_used"] boolValue]){
                 // check device and update rssi_bias
                 NSString *deviceName = [NavUtil deviceModel];
                 NSString *configKey = [@"rssi_bias_m_" stringByAppendingString:deviceName];
                 // check if configKey exists in the user defaults.
                 if ([ud objectForKey:configKey] != nil){
-                    rssiBias = [ud floatForKey:configKey];
+                    rssiBias = [ud[configKey] floatValue];
                 }
             }
             params[@"minRssiBias"] = @(rssiBias-0.1);
@@ -312,7 +317,7 @@
             return;
         }
         else if ([from isEqualToString:@"rep_location"]) {
-            NSString *rep_location = [ud stringForKey:@"rep_location"];
+            NSString *rep_location = ud[@"rep_location"];
             if([rep_location isEqualToString:@"mean"]){
                 value = @(HLPLocationManagerRepLocationMean);
             }else if([rep_location isEqualToString:@"densest"]){
@@ -322,7 +327,7 @@
             }
         }
         else {
-            value = [ud valueForKey:from];
+            value = ud[from];
         }
 
         params[to] = value;
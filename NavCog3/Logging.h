@@ -31,4 +31,12 @@
 + (BOOL)isSensorLogging;
 + (void)logType:(NSString*)type withParam:(NSDictionary*)param;
 
+// latency tracing, a span is started for each location update and marked at each stage
++ (long)traceBegin:(NSString*)stage;
++ (void)trace:(long)span stage:(NSString*)stage;
++ (void)setTraceActiveSpan:(long)span;
++ (long)traceActiveSpan;
++ (NSDictionary*)traceReport;
++ (void)traceReset;
+
 @end
@@ -23,6 +23,16 @@
 
 #import "Logging.h"
 
+#define TRACE_RING_SIZE 4096
+#define TRACE_MAX_STAGES 16
+
+typedef struct {
+    long span;
+    int stage;
+    BOOL begin;
+    NSTimeInterval time;
+} TraceRecord;
+
 void NavNSLog(NSString* fmt, ...) {
     va_list args;
     va_start(args, fmt);
@@ -73,6 +83,10 @@ static BOOL isSensorLogging = true;
     if(stderrSave == 0) {
         return;
     }
+    NSDictionary *report = [self traceReport];
+    if (report.count > 0) {
+        [self logType:@"trace" withParam:report];
+    }
     if (stderrSave > 0) {
         fflush(stderr);
         dup2(stderrSave, STDERR_FILENO);
@@ -99,5 +113,128 @@ static BOOL isSensorLogging = true;
     NSLog(@"%@,%ld,%@", type, timestamp, paramStr);
 }
 
+#pragma mark - latency tracing
+
+static TraceRecord traceRing[TRACE_RING_SIZE];
+static long traceCount = 0;
+static long traceLastSpan = 0;
+static NSString *traceStages[TRACE_MAX_STAGES];
+static int traceStageCount = 0;
+static __thread long traceActive = 0;
+
++ (long)traceBegin:(NSString *)stage
+{
+    long span;
+    @synchronized(self) {
+        span = ++traceLastSpan;
+    }
+    [self trace:span stage:stage begin:YES];
+    return span;
+}
+
++ (void)trace:(long)span stage:(NSString *)stage
+{
+    [self trace:span stage:stage begin:NO];
+}
+
++ (void)trace:(long)span stage:(NSString *)stage begin:(BOOL)begin
+{
+    if (span <= 0) {
+        return;
+    }
+    // systemUptime is monotonic, unlike the wall clock used for log lines
+    NSTimeInterval now = [[NSProcessInfo processInfo] systemUptime];
+    @synchronized(self) {
+        int index = 0;
+        for(; index < traceStageCount; index++) {
+            if (traceStages[index] == stage || [traceStages[index] isEqualToString:stage]) {
+                break;
+            }
+        }
+        if (index == traceStageCount) {
+            if (traceStageCount == TRACE_MAX_STAGES) {
+                return;
+            }
+            traceStages[traceStageCount++] = [stage copy];
+        }
+        traceRing[traceCount % TRACE_RING_SIZE] = (TraceRecord){span, index, begin, now};
+        traceCount++;
+    }
+}
+
+// the span being processed on the current thread, used by stages which do not receive it explicitly
++ (void)setTraceActiveSpan:(long)span
+{
+    traceActive = span;
+}
+
++ (long)traceActiveSpan
+{
+    return traceActive;
+}
+
++ (NSDictionary *)traceReport
+{
+    long n;
+    TraceRecord *records;
+    NSMutableArray *stages = [@[] mutableCopy];
+    @synchronized(self) {
+        n = MIN(traceCount, TRACE_RING_SIZE);
+        records = malloc(sizeof(TraceRecord) * MAX(n, 1));
+        for(long i = 0; i < n; i++) {
+            records[i] = traceRing[(traceCount - n + i) % TRACE_RING_SIZE];
+        }
+        for(int i = 0; i < traceStageCount; i++) {
+            [stages addObject:traceStages[i]];
+        }
+    }
+    
+    // elapsed time of each stage from the beginning of its span,
+    // spans whose beginning was already overwritten in the ring are skipped
+    NSMutableDictionary *begins = [@{} mutableCopy];
+    NSMutableArray *elapsed = [@[] mutableCopy];
+    for(int i = 0; i < stages.count; i++) {
+        [elapsed addObject:[@[] mutableCopy]];
+    }
+    for(long i = 0; i < n; i++) {
+        NSNumber *span = @(records[i].span);
+        if (records[i].begin) {
+            begins[span] = @(records[i].time);
+            continue;
+        }
+        NSNumber *begin = begins[span];
+        if (begin) {
+            [elapsed[records[i].stage] addObject:@((records[i].time - [begin doubleValue]) * 1000)];
+        }
+    }
+    free(records);
+    
+    NSMutableDictionary *report = [@{} mutableCopy];
+    for(int i = 0; i < stages.count; i++) {
+        NSArray *values = [elapsed[i] sortedArrayUsingSelector:@selector(compare:)];
+        if (values.count == 0) {
+            continue;
+        }
+        double(^percentile)(double) = ^(double p) {
+            return [values[MIN(values.count-1, (NSUInteger)(p * values.count))] doubleValue];
+        };
+        report[stages[i]] = @{
+                              @"count": @(values.count),
+                              @"p50": @(percentile(0.50)),
+                              @"p90": @(percentile(0.90)),
+                              @"p99": @(percentile(0.99)),
+                              @"max": values.lastObject
+                              };
+    }
+    return report;
+}
+
++ (void)traceReset
+{
+    @synchronized(self) {
+        traceCount = 0;
+    }
+}
+
 
 @end
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright (c) 2014, 2016  IBM Corporation, Carnegie Mellon University and others
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *******************************************************************************/
+
+#import "NavCoalescer.h"
+
+@implementation NavLatestCoalescer {
+    NSOperationQueue *_queue;
+    void(^_handler)(id, long);
+    id _pending;
+    long _dropped;
+}
+
+- (instancetype)initWithQueue:(NSOperationQueue *)queue handler:(void (^)(id, long))handler
+{
+    self = [super init];
+    _queue = queue;
+    _handler = handler;
+    return self;
+}
+
+- (void)submit:(id)object
+{
+    @synchronized(self) {
+        BOOL scheduled = _pending != nil;
+        _pending = object;
+        if (scheduled) {
+            _dropped++;
+            return;
+        }
+    }
+    [_queue addOperationWithBlock:^{
+        id latest;
+        long count;
+        @synchronized(self) {
+            latest = _pending;
+            count = _dropped;
+            _pending = nil;
+            _dropped = 0;
+        }
+        if (latest) {
+            _handler(latest, count);
+        }
+    }];
+}
+
+@end
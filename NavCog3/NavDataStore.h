@@ -81,7 +81,6 @@ typedef enum {
 @property (readonly) NSDictionary *nodesMap;
 @property (readonly) NSDictionary *linksMap;
 @property (readonly) NSDictionary *nodeLinksMap;
-@property (readonly) NSDictionary *linkPoiMap;
 @property (readonly) NSArray *pois;
 @property (readonly) NSArray *escalatorLinks;
 
@@ -134,6 +133,7 @@ typedef enum {
 - (HLPLink*) routeLinkById:(NSString*)linkID;
 - (HLPLink*) findElevatorLink:(HLPLink*)link;
 - (NSArray*) nearestLinksAt:(HLPLocation*)loc withOptions:(NSDictionary*)option;
+- (NSArray*) poisForLink:(HLPLink*)link;
 
 + (NavDestination*) destinationForCurrentLocation;
 
@@ -312,9 +312,6 @@
 @end
 
 @implementation NavDataStore {
-    // location instance that keep the current status should be handled
-    HLPLocation *location;
-    
     // parameters passed from location manager and manual operations
     BOOL isManualLocation;
     HLPLocation *manualCurrentLocation;
@@ -322,6 +319,7 @@
     HLPLocation *savedLocation;
     HLPLocation *savedCenterLocation;
     BOOL savedIsManualLocation;
+    NSNumber *pendingTrace;
     
     double magneticOrientation;
     double magneticOrientationAccuracy;
@@ -347,7 +345,13 @@
     NSDictionary *destinationHash;
     NSDictionary *serverConfig;
     
-    GKQuadtree *quadtree;
+    NSDictionary<NSNumber*, GKQuadtree*> *floorQuadtrees;
+    
+    // floor -> pois and entrances, and their association to links built on demand
+    NSDictionary *floorPoiSources;
+    NSDictionary *transitionLinkPoiMap;
+    NSMutableDictionary *floorLinkPoiMaps;
+    NSMutableArray *floorLinkPoiLRU;
 }
 
 static NavDataStore* instance_ = nil;
@@ -363,6 +367,8 @@ static NavDataStore* instance_ = nil;
 {
     self = [super init];
     
+    floorLinkPoiMaps = [@{} mutableCopy];
+    floorLinkPoiLRU = [@[] mutableCopy];
     [self reset];
     
     [self selectUserLanguage:[self userLanguageCandidates].firstObject];
@@ -436,8 +442,6 @@ static NavDataStore* instance_ = nil;
     
     magneticOrientationAccuracy = 180;
     
-    location = [[HLPLocation alloc] init];
-    [location updateOrientation:0 withAccuracy:999];
     currentLocation = [[HLPLocation alloc] init];
     [currentLocation updateOrientation:0 withAccuracy:999];
 
@@ -468,6 +472,8 @@ static NavDataStore* instance_ = nil;
     }
     
     NSDictionary *obj = [note userInfo];
+    pendingTrace = obj[@"trace"];
+    [Logging trace:[pendingTrace longValue] stage:@"datastore"];
     
     currentLocation = [[HLPLocation alloc] initWithLat:[obj[@"lat"] doubleValue]
                                                    Lng:[obj[@"lng"] doubleValue]
@@ -485,6 +491,7 @@ static NavDataStore* instance_ = nil;
     if (!(isManualLocation && devMode)) {
         [self postLocationNotification];
     }
+    pendingTrace = nil;
     if (!isManualLocation) {
         _mapCenter = currentLocation;
     }
@@ -505,6 +512,7 @@ static NavDataStore* instance_ = nil;
      @{
        @"current":loc?loc:[NSNull null],
        @"isManual":@(isManualLocation),
+       @"trace":pendingTrace?pendingTrace:@(0),
        
        // Removed nan check to publish unknown lat and lng
        //@"actual":(isnan(currentLocation.lat)||isnan(currentLocation.lng))?[NSNull null]:currentLocation
@@ -568,6 +576,8 @@ static NavDataStore* instance_ = nil;
     //    return nil;
     //}
     
+    // build the result directly, without a shared scratch instance and a second copy
+    HLPLocation *location = [[HLPLocation alloc] init];
     [location update:currentLocation];
     
     if (manualCurrentLocation) {
@@ -600,11 +610,7 @@ static NavDataStore* instance_ = nil;
     //    return nil;
     //}
     
-    HLPLocation *newLoc = [[HLPLocation alloc] init];
-    [newLoc update:location];
-    return newLoc;
-    
-    //return location;
+    return location;
 }
 
 - (NSArray *)route
@@ -686,8 +692,7 @@ static NavDataStore* instance_ = nil;
 
 - (NSString*)normalizePron:(NSString*)str
 {
-    NSMutableString* retStr = [[NSMutableString alloc] initWithString:str];
-    CFStringTransform((CFMutableStringRef)retStr, NULL, kCFStringTransformHiraganaKatakana, YES);
+    NSString* retStr = HLPNormalizeKana(str);
     
     NSRange range = [retStr rangeOfString:@"^[0-9]" options:NSRegularExpressionSearch];
     BOOL matches = range.location != NSNotFound;
@@ -917,6 +922,20 @@ static NavDataStore* instance_ = nil;
             link.escalatorFlags = [_linksMap[link._id] escalatorFlags];
         }
     }];
+    
+    // prepare poi association of the floors on the route before navigation asks for it
+    NSMutableSet *floors = [[NSMutableSet alloc] init];
+    for(HLPLink *link in routeCache) {
+        if ([link isKindOfClass:HLPLink.class]) {
+            [floors addObject:@(link.sourceHeight)];
+            [floors addObject:@(link.targetHeight)];
+        }
+    }
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        for(NSNumber *floor in floors) {
+            [self linkPoiMapOnFloor:[floor doubleValue]];
+        }
+    });
 }
 
 // attribute names of hokoukukan network data in Japanese
@@ -926,6 +945,9 @@ static NavDataStore* instance_ = nil;
 #define FACILITY_ID @"施設ID"
 #define FOR_FACILITY_ID @"対応施設ID"
 
+// number of floors whose poi association is kept in memory
+#define LINK_POI_FLOOR_CACHE_SIZE 8
+
 MKMapPoint convertFromGlobal(HLPLocation* global, HLPLocation* rp) {
     double distance = [HLPLocation distanceFromLat:global.lat Lng:global.lng toLat:rp.lat Lng:rp.lng];
     double d2r = M_PI / 180;
@@ -1100,14 +1122,35 @@ MKMapPoint convertFromGlobal(HLPLocation* global, HLPLocation* rp) {
     struct GKQuad q;
     q.quadMin = (vector_float2){minx, miny};
     q.quadMax = (vector_float2){maxx, maxy};
-    quadtree = [GKQuadtree quadtreeWithBoundingQuad:q minimumCellSize:100];
+    
+    // one quadtree per floor, a link is put into the trees of both of its ends
+    // so that links connecting floors (elevator, escalator, stairs) are found from either floor
+    NSMutableDictionary *floorQuadtreesTemp = [@{} mutableCopy];
+    GKQuadtree*(^quadtreeOnFloor)(double) = ^(double floor) {
+        GKQuadtree *tree = floorQuadtreesTemp[@(floor)];
+        if (!tree) {
+            tree = [GKQuadtree quadtreeWithBoundingQuad:q minimumCellSize:100];
+            floorQuadtreesTemp[@(floor)] = tree;
+        }
+        return tree;
+    };
     
     [self.linksMap enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, HLPLink *link, BOOL * _Nonnull stop) {
+        NSMutableArray *trees = [@[quadtreeOnFloor(link.sourceHeight)] mutableCopy];
+        if (link.targetHeight != link.sourceHeight) {
+            [trees addObject:quadtreeOnFloor(link.targetHeight)];
+        }
+        void(^addPoint)(MKMapPoint) = ^(MKMapPoint p) {
+            for(GKQuadtree *tree in trees) {
+                [tree addElement:link withPoint:(vector_float2){p.x, p.y}];
+            }
+        };
+        
         MKMapPoint ms = convertFromGlobal(link.sourceLocation, rp);
         MKMapPoint mt = convertFromGlobal(link.targetLocation, rp);
         
-        [quadtree addElement:link withPoint:(vector_float2){ms.x, ms.y}];
-        [quadtree addElement:link withPoint:(vector_float2){mt.x, mt.y}];
+        addPoint(ms);
+        addPoint(mt);
         
         double d = sqrt(pow(ms.x-mt.x, 2)+pow(ms.y-mt.y, 2));
         //NSLog(@"quadtree,%f, %f, %f, %f, %f", ms.x, ms.y, mt.x, mt.y, d);
@@ -1115,8 +1158,8 @@ MKMapPoint convertFromGlobal(HLPLocation* global, HLPLocation* rp) {
             double r = 1;
             MKMapPoint ms2 = MKMapPointMake((ms.x*(d-r)+mt.x*r)/d, (ms.y*(d-r)+mt.y*r)/d);
             MKMapPoint mt2 = MKMapPointMake((mt.x*(d-r)+ms.x*r)/d, (mt.y*(d-r)+ms.y*r)/d);
-            [quadtree addElement:link withPoint:(vector_float2){ms2.x, ms2.y}];
-            [quadtree addElement:link withPoint:(vector_float2){mt2.x, mt2.y}];
+            addPoint(ms2);
+            addPoint(mt2);
             ms = ms2;
             mt = mt2;
             d = sqrt(pow(ms.x-mt.x, 2)+pow(ms.y-mt.y, 2));
@@ -1124,58 +1167,74 @@ MKMapPoint convertFromGlobal(HLPLocation* global, HLPLocation* rp) {
         }
         //NSLog(@"quadtree------ %f (%f).", d, [link.sourceLocation distanceTo:link.targetLocation]);
     }];
-    
-    // associate pois to links
-    NSMutableDictionary *linkPoiMap = [@{} mutableCopy];
+    floorQuadtrees = floorQuadtreesTemp;
+    
+    // pois and entrances are associated to links lazily per floor (see poisForLink:),
+    // only elevator pois and ones without floor, which may belong to any floor, are associated here
+    NSMutableDictionary *floorSources = [@{} mutableCopy];
+    NSMutableArray *transitionSources = [@[] mutableCopy];
+    void(^addSource)(id, double) = ^(id obj, double floor) {
+        if (isnan(floor)) {
+            [transitionSources addObject:obj];
+            return;
+        }
+        NSMutableArray *array = floorSources[@(floor)];
+        if (!array) {
+            array = [@[] mutableCopy];
+            floorSources[@(floor)] = array;
+        }
+        [array addObject:obj];
+    };
     for(int j = 0; j < [_pois count]; j++) {
         if ([_pois[j] isKindOfClass:HLPPOI.class] == NO) {
             continue;
         }
         HLPPOI *poi = _pois[j];
-        HLPLocation *poiLoc = poi.location;
-        HLPLinkType linkType = 0;
         if (poi.poiCategory == HLPPOICategoryElevatorEquipments ||
             poi.poiCategory == HLPPOICategoryElevator
             ) {
-            linkType = LINK_TYPE_ELEVATOR;
-            [poiLoc updateFloor:NAN];
+            addSource(poi, NAN);
+        } else {
+            addSource(poi, poi.location.floor);
         }
-        NSArray *links = [self nearestLinksAt:poiLoc withOptions:
-                          @{@"linkType":@(linkType),
-                            @"POI_DISTANCE_MIN_THRESHOLD":@(10)}];
-        
-        for(HLPLink* nearestLink in links) {
-            NSMutableArray *linkPois = linkPoiMap[nearestLink._id];
-            if (!linkPois) {
-                linkPois = [@[] mutableCopy];
-                linkPoiMap[nearestLink._id] = linkPois;
-            }
-            [linkPois addObject:poi];
+    }
+    for(HLPEntrance *ent in features) {
+        if ([ent isKindOfClass:HLPEntrance.class] && ent.node) { // no node for special door tag
+            addSource(ent, ent.node.location.floor);
         }
     }
     
-    //HLPEntrance *destinationNode = _entranceMap[[[self.route lastObject] _id]];
-    //HLPEntrance *startNode = _entranceMap[[[self.route firstObject] _id]];;
+    NSDictionary *transitionMap = [self associatePois:transitionSources];
+    @synchronized(floorLinkPoiMaps) {
+        floorPoiSources = floorSources;
+        transitionLinkPoiMap = transitionMap;
+        [floorLinkPoiMaps removeAllObjects];
+        [floorLinkPoiLRU removeAllObjects];
+    }
+}
+
+// returns link id -> pois (HLPPOI and HLPEntrance) whose nearest links include the link
+- (NSDictionary*) associatePois:(NSArray*)pois
+{
+    NSMutableDictionary *linkPoiMap = [@{} mutableCopy];
+    void(^addPoi)(HLPLink*, id) = ^(HLPLink *nearestLink, id poi) {
+        NSMutableArray *linkPois = linkPoiMap[nearestLink._id];
+        if (!linkPois) {
+            linkPois = [@[] mutableCopy];
+            linkPoiMap[nearestLink._id] = linkPois;
+        }
+        [linkPois addObject:poi];
+    };
     
-    for(HLPEntrance *ent in features) {
-        if ([ent isKindOfClass:HLPEntrance.class]) {
-            /*
-            if ([startNode.forFacilityID isEqualToString:ent.forFacilityID]) {
-                //continue;
-            }
-            if ([destinationNode.forFacilityID isEqualToString:ent.forFacilityID]) {
-                //NSLog(@"%@", ent);
-            }
-             */
-            if (!ent.node) { // special door tag
-                continue;
-            }
+    for(id obj in pois) {
+        if ([obj isKindOfClass:HLPEntrance.class]) {
+            HLPEntrance *ent = obj;
             //NSLog(@"Facility: %@ %@", ent._id, ent.facility.name);
             
             BOOL isLeaf = ent.node.isLeaf;
             NSMutableDictionary *opt = [isLeaf?@{@"onlyEnd":@(YES)}:@{} mutableCopy];
             opt[@"POI_DISTANCE_MIN_THRESHOLD"] = @(10);
-
+            
             NSArray *links = [self nearestLinksAt:ent.node.location withOptions:opt];
             for(HLPLink* nearestLink in links) {
                 if ([nearestLink.sourceNodeID isEqualToString:ent.node._id] ||
@@ -1183,26 +1242,90 @@ MKMapPoint convertFromGlobal(HLPLocation* global, HLPLocation* rp) {
                     //TODO announce about building
                     //continue;
                 }
-                NSMutableArray *linkPois = linkPoiMap[nearestLink._id];
-                if (!linkPois) {
-                    linkPois = [@[] mutableCopy];
-                    linkPoiMap[nearestLink._id] = linkPois;
-                }
-                [linkPois addObject:ent];
-                //NSLog(@"%@", nearestLink._id);
-                //break;
+                addPoi(nearestLink, ent);
+            }
+        } else {
+            HLPPOI *poi = obj;
+            HLPLocation *poiLoc = poi.location;
+            HLPLinkType linkType = 0;
+            if (poi.poiCategory == HLPPOICategoryElevatorEquipments ||
+                poi.poiCategory == HLPPOICategoryElevator
+                ) {
+                linkType = LINK_TYPE_ELEVATOR;
+                [poiLoc updateFloor:NAN];
+            }
+            NSArray *links = [self nearestLinksAt:poiLoc withOptions:
+                              @{@"linkType":@(linkType),
+                                @"POI_DISTANCE_MIN_THRESHOLD":@(10)}];
+            for(HLPLink* nearestLink in links) {
+                addPoi(nearestLink, poi);
             }
         }
     }
-    _linkPoiMap = linkPoiMap;
-    // end associate pois to links
+    return linkPoiMap;
+}
+
+// a poi on a floor can only be associated to links which have the floor at either end,
+// so the association of a floor is built on the first request and kept in a small LRU cache.
+// the lock is only held to look up and insert, the association is built outside of it
+- (NSDictionary*) linkPoiMapOnFloor:(double)floor
+{
+    NSNumber *key = @(floor);
+    NSDictionary *sources;
+    @synchronized(floorLinkPoiMaps) {
+        NSDictionary *map = floorLinkPoiMaps[key];
+        if (map) {
+            [floorLinkPoiLRU removeObject:key];
+            [floorLinkPoiLRU addObject:key];
+            return map;
+        }
+        sources = floorPoiSources;
+    }
+    
+    NSDictionary *map = [self associatePois:sources[key]];
+    
+    @synchronized(floorLinkPoiMaps) {
+        if (sources != floorPoiSources) {
+            // the features were reloaded while building, do not cache the old association
+            return map;
+        }
+        NSDictionary *other = floorLinkPoiMaps[key];
+        if (other) {
+            // another thread built it first
+            [floorLinkPoiLRU removeObject:key];
+            [floorLinkPoiLRU addObject:key];
+            return other;
+        }
+        floorLinkPoiMaps[key] = map;
+        [floorLinkPoiLRU addObject:key];
+        while(floorLinkPoiLRU.count > LINK_POI_FLOOR_CACHE_SIZE) {
+            [floorLinkPoiMaps removeObjectForKey:floorLinkPoiLRU.firstObject];
+            [floorLinkPoiLRU removeObjectAtIndex:0];
+        }
+        return map;
+    }
+}
 
+- (NSArray*) poisForLink:(HLPLink*)link
+{
+    if (!link._id) {
+        return nil;
+    }
+    NSMutableArray *pois = [@[] mutableCopy];
+    @synchronized(floorLinkPoiMaps) {
+        [pois addObjectsFromArray:transitionLinkPoiMap[link._id]];
+    }
+    [pois addObjectsFromArray:[self linkPoiMapOnFloor:link.sourceHeight][link._id]];
+    if (link.targetHeight != link.sourceHeight) {
+        [pois addObjectsFromArray:[self linkPoiMapOnFloor:link.targetHeight][link._id]];
+    }
+    return pois.count > 0 ? pois : nil;
 }
 
 - (NSArray*) nearestLinksAt:(HLPLocation*)loc withOptions:(NSDictionary*)option
 {
-    NSMutableSet<HLPLink*> __block *nearestLinks = nil;
-    double __block minDistance = DBL_MAX;
+    NSMutableSet<HLPLink*> *nearestLinks = nil;
+    double minDistance = DBL_MAX;
     
     HLPLinkType linkType = [option[@"linkType"] intValue];
     BOOL onlyEnd = [option[@"onlyEnd"] boolValue];
@@ -1218,45 +1341,21 @@ MKMapPoint convertFromGlobal(HLPLocation* global, HLPLocation* rp) {
     q.quadMin = (vector_float2){(float)MIN(ms.x,mt.x), (float)MIN(ms.y,mt.y)};
     q.quadMax = (vector_float2){(float)MAX(ms.x,mt.x), (float)MAX(ms.y,mt.y)};
         
-    NSSet *links = [NSSet setWithArray:[quadtree elementsInQuad:q]];
-    [links enumerateObjectsUsingBlock:^(HLPLink *link, BOOL * _Nonnull stop) {
-        
-        if (!isnan(loc.floor) &&
-            (link.sourceHeight != loc.floor && link.targetHeight != loc.floor)) {
-            return;
-        }
-        if (link.isLeaf) {
-            return;
-        }
-        
-        HLPLocation *nearest = nil;
-        if (onlyEnd) {
-            double sd = [link.sourceLocation fastDistanceTo:loc];
-            double td = [link.targetLocation fastDistanceTo:loc];
-            if (sd > td) {
-                nearest = link.targetLocation;
-            } else {
-                nearest = link.sourceLocation;
-            }
-        } else {
-            nearest = [link nearestLocationTo:loc];
-        }
-        double distance = [loc fastDistanceTo:nearest];
-        
-        if (distance < minDistance && (linkType == 0 || link.linkType == linkType)) {
-            minDistance = distance;
-            nearestLinks = [[NSMutableSet alloc] init];
-            [nearestLinks addObject:link];
-        }
-    }];
-    [links enumerateObjectsUsingBlock:^(HLPLink *link, BOOL * _Nonnull stop) {
-        
-        if (!isnan(loc.floor) &&
-            (link.sourceHeight != loc.floor && link.targetHeight != loc.floor)) {
-            return;
+    // only the floor of the location is searched, or every floor if the floor is unknown
+    NSMutableSet *links = [[NSMutableSet alloc] init];
+    if (isnan(loc.floor)) {
+        for(GKQuadtree *tree in floorQuadtrees.allValues) {
+            [links addObjectsFromArray:[tree elementsInQuad:q]];
         }
-        if (link.isLeaf) {
-            return;
+    } else {
+        [links addObjectsFromArray:[floorQuadtrees[@(loc.floor)] elementsInQuad:q]];
+    }
+    
+    NSMutableArray<HLPLink*> *candidates = [@[] mutableCopy];
+    double *distances = malloc(sizeof(double) * MAX(links.count, 1));
+    for(HLPLink *link in links) {
+        if (link.isLeaf || (linkType != 0 && link.linkType != linkType)) {
+            continue;
         }
         
         HLPLocation *nearest = nil;
@@ -1273,11 +1372,18 @@ MKMapPoint convertFromGlobal(HLPLocation* global, HLPLocation* rp) {
         }
         double distance = [loc fastDistanceTo:nearest];
         
-        if (fabs(distance - minDistance) < 0.5 && (linkType == 0 || link.linkType == linkType)) {
-            [nearestLinks addObject:link];
+        distances[candidates.count] = distance;
+        [candidates addObject:link];
+        minDistance = MIN(minDistance, distance);
+    }
+    
+    nearestLinks = [[NSMutableSet alloc] init];
+    for(int i = 0; i < candidates.count; i++) {
+        if (fabs(distances[i] - minDistance) < 0.5) {
+            [nearestLinks addObject:candidates[i]];
         }
-    }];
-
+    }
+    free(distances);
 
     if (minDistance < (option[@"POI_DISTANCE_MIN_THRESHOLD"]?[option[@"POI_DISTANCE_MIN_THRESHOLD"] doubleValue]:5)) {
         return nearestLinks.allObjects;
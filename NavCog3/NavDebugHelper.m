@@ -27,8 +27,20 @@
 #import <CoreLocation/CoreLocation.h>
 #import <sys/sysctl.h>
 
+#define SEND_BATCH_MAX 16
+#define SEND_BATCH_DELAY 0.05
+
+// sent to each peer on connection; peers which send it back can receive batches,
+// older peers just post it as an unobserved notification and keep getting single messages
+#define BATCH_SUPPORTED_MESSAGE @"nav_debug_batch_supported"
+
 @implementation NavDebugHelper {
     NSMutableDictionary *_lastSent;
+    NSMutableArray *_pending;
+    BOOL _flushScheduled;
+    NSMutableSet *_batchPeers;
+    NSURLSession *_beaconSession;
+    BOOL _beaconPosting;
 }
 
 static NavDebugHelper* instance;
@@ -46,6 +58,13 @@ static NavDebugHelper* instance;
     self = [super init];
     _peers = [@[] mutableCopy];
     _lastSent = [@{} mutableCopy];
+    _pending = [@[] mutableCopy];
+    _batchPeers = [[NSMutableSet alloc] init];
+    
+    // one session for all beacon posts so the connection to the server is kept alive
+    NSURLSessionConfiguration *config = [NSURLSessionConfiguration defaultSessionConfiguration];
+    config.timeoutIntervalForRequest = 2;
+    _beaconSession = [NSURLSession sessionWithConfiguration:config];
     
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(processData:) name:NAV_LOCATION_CHANGED_NOTIFICATION object:nil];
 
@@ -81,15 +100,11 @@ static NavDebugHelper* instance;
 
     NSDictionary *userInfo = [note userInfo];
 
-    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:
-                    @{
-                      @"name": name,
-                      @"timestamp": @([[NSDate date] timeIntervalSince1970]),
-                      @"userInfo": userInfo?userInfo:[NSNull null]
-                      }];
-    if (data) {
-        [self sendData:data];
-    }
+    [self enqueueMessage:@{
+                           @"name": name,
+                           @"timestamp": @([[NSDate date] timeIntervalSince1970]),
+                           @"userInfo": userInfo?userInfo:[NSNull null]
+                           }];
 }
 
 - (void) processData2:(NSNotification*)note
@@ -109,14 +124,62 @@ static NavDebugHelper* instance;
     
     NSDictionary *userInfo = [note userInfo];
     
-    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:
-                    @{
-                      @"name": name,
-                      @"timestamp": @([[NSDate date] timeIntervalSince1970]),
-                      @"userInfo": userInfo?userInfo:[NSNull null]
-                      }];
-    if (data) {
-        [self sendData:data];
+    [self enqueueMessage:@{
+                           @"name": name,
+                           @"timestamp": @([[NSDate date] timeIntervalSince1970]),
+                           @"userInfo": userInfo?userInfo:[NSNull null]
+                           }];
+}
+
+// messages in a short window are archived together, so peers get one packet
+// and the archiver shares class and key tables between them
+- (void) enqueueMessage:(NSDictionary*)message
+{
+    BOOL flushNow = NO;
+    @synchronized(self) {
+        [_pending addObject:message];
+        if (_pending.count >= SEND_BATCH_MAX) {
+            flushNow = YES;
+        } else if (!_flushScheduled) {
+            _flushScheduled = YES;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SEND_BATCH_DELAY * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+                [self flushMessages];
+            });
+        }
+    }
+    if (flushNow) {
+        [self flushMessages];
+    }
+}
+
+- (void) flushMessages
+{
+    NSArray *messages;
+    NSMutableArray *batchPeers = [@[] mutableCopy];
+    NSMutableArray *singlePeers = [@[] mutableCopy];
+    @synchronized(self) {
+        _flushScheduled = NO;
+        messages = _pending;
+        _pending = [@[] mutableCopy];
+        for(MCPeerID *peer in _peers) {
+            [([_batchPeers containsObject:peer] ? batchPeers : singlePeers) addObject:peer];
+        }
+    }
+    if (messages.count == 0) {
+        return;
+    }
+    if (batchPeers.count > 0) {
+        NSData *data = [NSKeyedArchiver archivedDataWithRootObject:
+                        messages.count == 1 ? messages[0] : @{@"batch": messages}];
+        if (data) {
+            [self sendData:data toPeers:batchPeers];
+        }
+    }
+    for(NSDictionary *message in (singlePeers.count > 0 ? messages : @[])) {
+        NSData *data = [NSKeyedArchiver archivedDataWithRootObject:message];
+        if (data) {
+            [self sendData:data toPeers:singlePeers];
+        }
     }
 }
 
@@ -135,12 +198,21 @@ static NavDebugHelper* instance;
 }
 
 - (void)sendData:(NSData *)data
+{
+    NSArray *peers;
+    @synchronized(self) {
+        peers = [_peers copy];
+    }
+    [self sendData:data toPeers:peers];
+}
+
+- (void)sendData:(NSData *)data toPeers:(NSArray*)peers
 {
     NSError *error;
     
-    if ([_peers count] > 0) {
+    if ([peers count] > 0) {
         [_session sendData:data
-                   toPeers:_peers
+                   toPeers:peers
                   withMode:MCSessionSendDataUnreliable
                      error:&error];
     }
@@ -150,21 +222,32 @@ static NavDebugHelper* instance;
 
 - (void)session:(MCSession *)session peer:(MCPeerID *)peerID didChangeState:(MCSessionState)state
 {
-    if (state == MCSessionStateConnected) {
-        if (![_peers containsObject:peerID]) {
-            [_peers addObject:peerID];
-        }
-    } else {
-        if ([_peers containsObject:peerID]) {
-            [_peers removeObject:peerID];
+    @synchronized(self) {
+        if (state == MCSessionStateConnected) {
+            if (![_peers containsObject:peerID]) {
+                [_peers addObject:peerID];
+            }
+        } else {
+            if ([_peers containsObject:peerID]) {
+                [_peers removeObject:peerID];
+            }
+            [_batchPeers removeObject:peerID];
         }
     }
+    if (state == MCSessionStateConnected) {
+        NSData *data = [NSKeyedArchiver archivedDataWithRootObject:@{
+                                                                     @"name": BATCH_SUPPORTED_MESSAGE,
+                                                                     @"timestamp": @([[NSDate date] timeIntervalSince1970]),
+                                                                     @"userInfo": @{}
+                                                                     }];
+        [_session sendData:data toPeers:@[peerID] withMode:MCSessionSendDataReliable error:nil];
+    }
     [[NSNotificationCenter defaultCenter] postNotificationName:DEBUG_PEER_STATE_CHANGE object:self  userInfo:@{@"peers":_peers}];
 }
 
 - (void)session:(MCSession *)session didReceiveData:(NSData *)data fromPeer:(MCPeerID *)peerID
 {
-    [self processReceivedData:data];
+    [self processReceivedData:data fromPeer:peerID];
 }
 
 - (void)session:(MCSession *)session
@@ -189,14 +272,21 @@ didReceiveStream:(NSInputStream *)stream
 {
 }
 
-- (void) processReceivedData:(NSData*)data
+- (void) processReceivedData:(NSData*)data fromPeer:(MCPeerID*)peerID
 {
     NSDictionary *json = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+    if ([json[@"name"] isEqualToString:BATCH_SUPPORTED_MESSAGE]) {
+        @synchronized(self) {
+            [_batchPeers addObject:peerID];
+        }
+        return;
+    }
+    NSArray *messages = json[@"batch"] ?: (json ? @[json] : @[]);
     dispatch_async(dispatch_get_main_queue(), ^{
-        if (json) {
-            NSString *name = json[@"name"];
-            double timestamp = [json[@"timestamp"] doubleValue];
-            NSDictionary *userInfo = json[@"userInfo"];
+        for(NSDictionary *message in messages) {
+            NSString *name = message[@"name"];
+            double timestamp = [message[@"timestamp"] doubleValue];
+            NSDictionary *userInfo = message[@"userInfo"];
         
             NSLog(@"receiveData,%ld,%@,%f", [data length], name, [[NSDate date] timeIntervalSince1970] - timestamp);
             [[NSNotificationCenter defaultCenter] postNotificationName:name object:self userInfo:userInfo];
@@ -263,9 +353,20 @@ didReceiveStream:(NSInputStream *)stream
         return;
     }
     
-    NSDictionary *json = [self buildBeaconJSON:beacons];
-    
     NSURL *url = [NSURL URLWithString:[NSString stringWithFormat:@"http://%@/beacon", [ud stringForKey:@"beacon_data_server"]]];
+    if (!url) {
+        return;
+    }
+    
+    // a post is issued per ranging, skip it while the previous one is in flight so a slow server does not queue them up
+    @synchronized(self) {
+        if (_beaconPosting) {
+            return;
+        }
+        _beaconPosting = YES;
+    }
+    
+    NSDictionary *json = [self buildBeaconJSON:beacons];
     
     NSMutableURLRequest *request = [[NSMutableURLRequest alloc] initWithURL:url];
     
@@ -274,16 +375,9 @@ didReceiveStream:(NSInputStream *)stream
     NSData *data = [NSJSONSerialization dataWithJSONObject:json options:0 error:nil];
     request.HTTPBody = data;
     
-    NSLog(@"%@", [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]);
-    
-    NSURLSessionConfiguration *config = [NSURLSessionConfiguration defaultSessionConfiguration];
-    config.timeoutIntervalForRequest = 2;
-    NSURLSession *session = [NSURLSession sessionWithConfiguration:config];
-    
-    NSURLSessionDataTask *task = [session dataTaskWithRequest:request completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
-        if (data != nil) {
-            NSLog(@"Send success");
-            //std::cout << "Send success" << std::endl;
+    NSURLSessionDataTask *task = [_beaconSession dataTaskWithRequest:request completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+        @synchronized(self) {
+            _beaconPosting = NO;
         }
         if (error) {
             NSLog(@"%@", [error localizedDescription]);
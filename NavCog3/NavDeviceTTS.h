@@ -52,6 +52,7 @@ typedef enum {
 @property NSTimeInterval speakFinish;
 @property BOOL selfvoicing;
 @property BOOL quickAnswer;
+@property long trace;
 @end
 
 @interface NavDeviceTTS : NSObject <AVSpeechSynthesizerDelegate>{
@@ -60,7 +61,7 @@ typedef enum {
     NSMutableArray *speaking;
     NSMutableDictionary *processing;
     AVSpeechSynthesizer *voice;
-    NSTimer *speakTimer;
+    long speakGeneration;
 }
 
 + (instancetype) sharedTTS;
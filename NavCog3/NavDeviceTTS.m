@@ -24,6 +24,7 @@
 #import <UIKit/UIKit.h>
 #import "LocationEvent.h"
 #import "NavDebugHelper.h"
+#import "Logging.h"
 
 @implementation HLPSpeechEntry
 
@@ -94,10 +95,7 @@ static NavDeviceTTS *instance = nil;
     isSpeaking = NO;
     voice = [[AVSpeechSynthesizer alloc] init];
     voice.delegate = self;
-    
-    dispatch_async(dispatch_get_main_queue(), ^{
-        speakTimer = [NSTimer scheduledTimerWithTimeInterval:0.1 target:self selector:@selector(processSpeak:) userInfo:nil repeats:YES];
-    });
+    speakGeneration++;
 }
 
 - (void) routeChanged
@@ -123,9 +121,36 @@ static NavDeviceTTS *instance = nil;
     return isSpeaking;
 }
 
+static NSMutableDictionary<NSString*, AVSpeechSynthesisVoice*> *voiceCache;
+
+// speechVoices scans all installed voices, so the result is cached per language
++ (AVSpeechSynthesisVoice*)cachedVoiceFor:(NSString*)key orCreate:(AVSpeechSynthesisVoice*(^)(void))create
+{
+    @synchronized(self) {
+        if (!voiceCache) {
+            voiceCache = [@{} mutableCopy];
+        }
+        AVSpeechSynthesisVoice *v = voiceCache[key];
+        if (!v) {
+            v = create();
+            if (v) {
+                voiceCache[key] = v;
+            }
+        }
+        return v;
+    }
+}
+
 + (AVSpeechSynthesisVoice*)getVoice {
-    // From http://stackoverflow.com/a/23826135/427299
     NSString *language = [[[NSBundle mainBundle] preferredLocalizations] objectAtIndex:0];
+    NSString *key = [NSString stringWithFormat:@"default:%@:%@", language, [AVSpeechSynthesisVoice currentLanguageCode]];
+    return [NavDeviceTTS cachedVoiceFor:key orCreate:^AVSpeechSynthesisVoice *{
+        return [NavDeviceTTS _getVoice:language];
+    }];
+}
+
++ (AVSpeechSynthesisVoice*)_getVoice:(NSString*)language {
+    // From http://stackoverflow.com/a/23826135/427299
     NSString *voiceLangCode = [AVSpeechSynthesisVoice currentLanguageCode];
     if (![voiceLangCode hasPrefix:language]) {
         // the default voice can't speak the language the text is localized to;
@@ -143,11 +168,16 @@ static NavDeviceTTS *instance = nil;
 
 
 + (AVSpeechSynthesisVoice*)getVoiceOfLang:(NSString *)language {
+    return [NavDeviceTTS cachedVoiceFor:language orCreate:^AVSpeechSynthesisVoice *{
+        return [NavDeviceTTS _getVoiceOfLang:language];
+    }];
+}
+
++ (AVSpeechSynthesisVoice*)_getVoiceOfLang:(NSString *)language {
 
     NSString *voiceLangCode;
     NSArray *speechVoices = [AVSpeechSynthesisVoice speechVoices];
     for (AVSpeechSynthesisVoice *speechVoice in speechVoices) {
-        NSLog(@"%@", speechVoice.language);
         if ([speechVoice.language hasPrefix:language]) {
             voiceLangCode = speechVoice.language;
             break;
@@ -167,6 +197,7 @@ static NavDeviceTTS *instance = nil;
     @synchronized(speaking) {
         [speaking addObject:se];
     }
+    [self processSpeakLater];
 }
 
 - (void)speakFromNotification:(NSNotification*)note
@@ -273,6 +304,8 @@ static NavDeviceTTS *instance = nil;
     se.selfvoicing = selfvoicing;
     se.issued = [[NSDate date] timeIntervalSince1970];
     se.quickAnswer = quickAnswer;
+    se.trace = [Logging traceActiveSpan];
+    [Logging trace:se.trace stage:@"tts_queue"];
     
     se.completionHandler = handler;
     
@@ -287,17 +320,28 @@ static NavDeviceTTS *instance = nil;
         }
         isSpeaking = NO;
         isProcessing = NO;
+        [self processSpeakLater];
         return se.ut;
     }
     
     @synchronized(speaking) {
         [speaking addObject:se];
     }
+    [self processSpeakLater];
     
     return se.ut;
 }
 
-- (void) processSpeak:(NSTimer*) timer
+// the queue is processed on the main thread whenever an entry is queued,
+// a speech or a pause finishes, or the estimated duration of a speech expires
+- (void) processSpeakLater
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self processSpeak];
+    });
+}
+
+- (void) processSpeak
 {
     NSTimeInterval now = [[NSDate date] timeIntervalSince1970];
     if (!isnan(expire) && now > expire) {
@@ -318,12 +362,14 @@ static NavDeviceTTS *instance = nil;
         //NSLog(@"speak_pause(%.2f)", se.pauseDuration);
         dispatch_after(popTime, dispatch_get_main_queue(), ^(void){
             isProcessing = NO;
+            [self processSpeak];
         });
         return;
     }
     
     [processing setObject:se forKey:se.ut.speechString];
     se.speakStart = [[NSDate date] timeIntervalSince1970];
+    [Logging trace:se.trace stage:@"tts_speak"];
     isSpeaking = YES;
     double(^estimatedDuration)(HLPSpeechEntry *) = ^(HLPSpeechEntry* se) {
         double r = se.ut.rate;
@@ -339,6 +385,15 @@ static NavDeviceTTS *instance = nil;
     };
     double duration = estimatedDuration(se);
     expire = now + duration;
+    
+    // fallback in case no delegate callback is received for this speech
+    long generation = ++speakGeneration;
+    dispatch_time_t expireTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)((duration + 0.1) * NSEC_PER_SEC));
+    dispatch_after(expireTime, dispatch_get_main_queue(), ^(void){
+        if (generation == speakGeneration) {
+            [self processSpeak];
+        }
+    });
 
     if (!se.selfvoicing && [self speakWithVoiceOver:se.ut.speechString]) {
         return;
@@ -363,6 +418,7 @@ static NavDeviceTTS *instance = nil;
     if (se && se.completionHandler) {
         se.completionHandler();
     }
+    [self processSpeakLater];
 }
 
 
@@ -388,6 +444,7 @@ static NavDeviceTTS *instance = nil;
             if (se && se.completionHandler) {
                 se.completionHandler();
             }
+            [self processSpeakLater];
         }
     }
 }
@@ -408,6 +465,7 @@ static NavDeviceTTS *instance = nil;
             se.completionHandler();
         }
     }
+    [self processSpeakLater];
 }
 
 - (void)voiceOverDidFinishAnnouncing:(NSNotification*)note
@@ -433,6 +491,7 @@ static NavDeviceTTS *instance = nil;
         if (se.completionHandler) {
             se.completionHandler();
         }
+        [self processSpeakLater];
     }    
 }
 
@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright (c) 2014, 2016  IBM Corporation, Carnegie Mellon University and others
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *******************************************************************************/
+
+#import "NavStrings.h"
+#import <FormatterKit/TTTOrdinalNumberFormatter.h>
+
+NSString* NavCachedLocalizedString(NSString *key, NSString *table)
+{
+    static NSMutableDictionary<NSString*, NSMutableDictionary<NSString*, NSString*>*> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [@{} mutableCopy];
+    });
+    if (key == nil || table == nil) {
+        return NSLocalizedStringFromTable(key, table, @"");
+    }
+    @synchronized(cache) {
+        NSMutableDictionary *tableCache = cache[table];
+        if (!tableCache) {
+            tableCache = cache[table] = [@{} mutableCopy];
+        }
+        NSString *str = tableCache[key];
+        if (str == nil) {
+            str = NSLocalizedStringFromTable(key, table, @"");
+            tableCache[key] = str;
+        }
+        return str;
+    }
+}
+
+NSString* NavOrdinalNumberString(NSNumber *number, NSString *localeStr)
+{
+    static TTTOrdinalNumberFormatter *formatter;
+    static NSString *formatterLocale;
+    @synchronized([TTTOrdinalNumberFormatter class]) {
+        if (formatter == nil || !(localeStr == formatterLocale || [localeStr isEqualToString:formatterLocale])) {
+            formatter = [[TTTOrdinalNumberFormatter alloc] init];
+            [formatter setLocale:[NSLocale localeWithLocaleIdentifier:localeStr]];
+            [formatter setGrammaticalGender:TTTOrdinalNumberFormatterMaleGender];
+            formatterLocale = localeStr;
+        }
+        return [formatter stringFromNumber:number];
+    }
+}
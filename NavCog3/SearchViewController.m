@@ -38,6 +38,7 @@
 
 @implementation SearchViewController {
     NavSearchHistoryDataSource *historySource;
+    BOOL locationUpdateScheduled;
 }
 
 - (void)viewDidLoad {
@@ -183,7 +184,17 @@
 
 - (void) locationChanged:(NSNotification*)note
 {
+    // the view reads the latest location, fixes arriving before it updates are skipped
+    @synchronized(self) {
+        if (locationUpdateScheduled) {
+            return;
+        }
+        locationUpdateScheduled = YES;
+    }
     dispatch_async(dispatch_get_main_queue(), ^{
+        @synchronized(self) {
+            locationUpdateScheduled = NO;
+        }
         //[self.historyView reloadData];
         [self updateViewWithFlag:NO];
     });
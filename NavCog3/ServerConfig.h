@@ -73,6 +73,10 @@ typedef NSArray<ServerEntry*> ServerList;
 
 - (void) requestServerConfig:(void(^_Nullable)(NSDictionary* _Nullable config))complete;
 - (NSArray* _Nonnull) checkDownloadFiles;
+// Moves a downloaded file (or applies a downloaded delta patch) into the location directory.
+// Returns NO when a patch could not be applied or the result does not match the expected hash;
+// the caller should then download entry[@"fallback"] instead.
+- (BOOL) installDownloadedFile:(NSURL* _Nonnull)location forEntry:(NSDictionary* _Nonnull)entry;
 - (void) checkAgreementForIdentifier:(NSString* _Nonnull)identifier withCompletion:(void(^_Nullable)(NSDictionary* _Nullable config))complete;
 
 - (NSURL* _Nonnull) getDestLocation:(NSString* _Nonnull)path;
@@ -23,8 +23,21 @@
 
 #import "ServerConfig.h"
 #import "HLPDataUtil.h"
+#import <CommonCrypto/CommonCrypto.h>
 
 #define SERVERLIST_URLS @[@"https://hulop.github.io/serverlist.json", @"secondary", @"and so on"]
+#define MANIFEST_FILE @"location_manifest.json"
+
+// delta patch format (all integers are unsigned LEB128 varints)
+//   "HLPD" version(1)
+//   op 0x01: copy  <offset> <length>  bytes from the installed file
+//   op 0x02: add   <length> <bytes>   literal bytes from the patch
+//   op 0x00: end
+#define PATCH_MAGIC "HLPD"
+#define PATCH_VERSION 1
+#define PATCH_OP_END 0x00
+#define PATCH_OP_COPY 0x01
+#define PATCH_OP_ADD 0x02
 
 @interface I18nStringsTransformer: NSValueTransformer
 @end
@@ -188,6 +201,7 @@ static I18nStringsTransformer *I18nStringsTransformerInstance;
     NSURL* targetDir;
     int _requestCount;
     ServerEntry* _selected;
+    NSMutableDictionary* manifest;
 }
 
 static ServerConfig *instance;
@@ -368,15 +382,11 @@ static ServerConfig *instance;
     if (map_files) {
         NSMutableArray *maps = [[NSMutableArray alloc] init];
         [map_files enumerateObjectsUsingBlock:^(NSDictionary *obj, NSUInteger idx, BOOL *stop) {
-            NSString *src = [obj objectForKey:@"src"];
-            long size = [[obj objectForKey:@"size"] longValue];
-            if (![self checkIfExists:src size:size]) {
-                [files addObject:@{
-                                   @"length": @(size),
-                                   @"url": [self.selected URLWithPath: src]
-                                   }];
+            NSDictionary *file = [self downloadEntryFor:obj];
+            if (file) {
+                [files addObject:file];
             }
-            [maps addObject:[self getDestLocation:src].path];
+            [maps addObject:[self getDestLocation:obj[@"src"]].path];
         }];
         [config_json setObject:maps forKey:@"map_files"];
     }
@@ -386,15 +396,11 @@ static ServerConfig *instance;
             if ([key isEqualToString:@"preset_for_sighted"]) { // backward compatibility
                 key = @"preset_for_general";
             }
-            NSString *src = [preset objectForKey:@"src"];
-            long size = [[preset objectForKey:@"size"] longValue];
-            if (![self checkIfExists:src size:size]) {
-                [files addObject:@{
-                                   @"length": @(size),
-                                   @"url": [self.selected URLWithPath: src]
-                                   }];
+            NSDictionary *file = [self downloadEntryFor:preset];
+            if (file) {
+                [files addObject:file];
             }
-            [config_json setValue:[self getDestLocation:src].path forKey:key];
+            [config_json setValue:[self getDestLocation:preset[@"src"]].path forKey:key];
         }
     }];
     
@@ -406,6 +412,46 @@ static ServerConfig *instance;
     return files;
 }
 
+// returns nil if the file is up to date, a delta patch entry if the server provides
+// a patch from the installed version, otherwise the full file entry
+- (NSDictionary*) downloadEntryFor:(NSDictionary*)obj
+{
+    NSString *src = obj[@"src"];
+    long size = [obj[@"size"] longValue];
+    NSString *hash = obj[@"hash"];
+    
+    NSMutableDictionary *full = [@{
+                                   @"length": @(size),
+                                   @"url": [self.selected URLWithPath: src],
+                                   @"src": src
+                                   } mutableCopy];
+    if (hash == nil) {
+        return [self checkIfExists:src size:size] ? nil : full;
+    }
+    full[@"hash"] = hash;
+    
+    NSString *installed = [self installedHashOf:src];
+    if (installed == nil) {
+        return full;
+    }
+    if ([installed caseInsensitiveCompare:hash] == NSOrderedSame) {
+        return nil;
+    }
+    for(NSDictionary *patch in obj[@"patches"]) {
+        if (patch[@"from"] && patch[@"src"] &&
+            [installed caseInsensitiveCompare:patch[@"from"]] == NSOrderedSame) {
+            return @{
+                     @"length": patch[@"size"]?:@(0),
+                     @"url": [self.selected URLWithPath: patch[@"src"]],
+                     @"src": src,
+                     @"hash": hash,
+                     @"patch": @(YES),
+                     @"fallback": full
+                     };
+        }
+    }
+    return full;
+}
 
 - (NSURL*) getDestLocation:(NSString*)path {
     return [NSURL URLWithString:[NSURL URLWithString:path].lastPathComponent relativeToURL:targetDir];
@@ -425,6 +471,198 @@ static ServerConfig *instance;
     return NO;
 }
 
+#pragma mark - manifest
+
+- (NSMutableDictionary*) manifest
+{
+    if (!manifest) {
+        NSData *data = [NSData dataWithContentsOfURL:[self getDestLocation:MANIFEST_FILE]];
+        NSDictionary *json = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+        manifest = [json isKindOfClass:NSDictionary.class] ? [json mutableCopy] : [@{} mutableCopy];
+    }
+    return manifest;
+}
+
+- (void) saveManifest
+{
+    NSData *data = [NSJSONSerialization dataWithJSONObject:self.manifest options:0 error:nil];
+    [data writeToURL:[self getDestLocation:MANIFEST_FILE] atomically:YES];
+}
+
+// hash of the installed file, cached in the manifest while size and modification date are unchanged
+- (NSString*) installedHashOf:(NSString*)src
+{
+    NSString *filePath = [self getDestLocation:src].path;
+    NSDictionary *attribute = [[NSFileManager defaultManager] attributesOfItemAtPath:filePath error:nil];
+    if (attribute == nil) {
+        return nil;
+    }
+    NSNumber *size = attribute[NSFileSize];
+    NSNumber *mtime = @([attribute[NSFileModificationDate] timeIntervalSince1970]);
+    
+    NSString *name = filePath.lastPathComponent;
+    NSDictionary *cached = self.manifest[name];
+    if (cached && [cached[@"size"] isEqual:size] && [cached[@"mtime"] isEqual:mtime]) {
+        return cached[@"hash"];
+    }
+    NSString *hash = [ServerConfig SHA256OfFile:filePath];
+    if (hash) {
+        self.manifest[name] = @{@"hash":hash, @"size":size, @"mtime":mtime};
+        [self saveManifest];
+    }
+    return hash;
+}
+
++ (NSString*) SHA256OfFile:(NSString*)path
+{
+    NSInputStream *stream = [NSInputStream inputStreamWithFileAtPath:path];
+    if (!stream) {
+        return nil;
+    }
+    [stream open];
+    CC_SHA256_CTX ctx;
+    CC_SHA256_Init(&ctx);
+    uint8_t buffer[64*1024];
+    NSInteger read;
+    while((read = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+        CC_SHA256_Update(&ctx, buffer, (CC_LONG)read);
+    }
+    [stream close];
+    if (read < 0) {
+        return nil;
+    }
+    unsigned char result[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(result, &ctx);
+    NSMutableString *ms = [@"" mutableCopy];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [ms appendFormat:@"%02x",result[i]];
+    }
+    return ms;
+}
+
+#pragma mark - install
+
+- (BOOL)installDownloadedFile:(NSURL *)location forEntry:(NSDictionary *)entry
+{
+    NSFileManager *fm = [NSFileManager defaultManager];
+    NSURL *destLocation = [self getDestLocation:entry[@"src"]];
+    NSURL *tempLocation = [destLocation URLByAppendingPathExtension:@"download"];
+    NSError *error = nil;
+    
+    [fm removeItemAtURL:tempLocation error:nil];
+    if ([entry[@"patch"] boolValue]) {
+        if (![self applyPatch:location toFile:destLocation output:tempLocation]) {
+            NSLog(@"could not apply patch to %@", destLocation.path);
+            [fm removeItemAtURL:tempLocation error:nil];
+            return NO;
+        }
+    } else {
+        NSLog(@"moving %@ to %@", location.path, tempLocation.path);
+        [fm moveItemAtURL:location toURL:tempLocation error:&error];
+        if (error) {
+            NSLog(@"error=%@", error);
+            return NO;
+        }
+    }
+    
+    NSString *hash = nil;
+    if (entry[@"hash"]) {
+        hash = [ServerConfig SHA256OfFile:tempLocation.path];
+        if (hash == nil || [hash caseInsensitiveCompare:entry[@"hash"]] != NSOrderedSame) {
+            NSLog(@"hash mismatch %@ (%@ != %@)", destLocation.path, hash, entry[@"hash"]);
+            [fm removeItemAtURL:tempLocation error:nil];
+            return NO;
+        }
+    }
+    
+    [fm removeItemAtURL:destLocation error:nil];
+    [fm moveItemAtURL:tempLocation toURL:destLocation error:&error];
+    if (error) {
+        NSLog(@"error=%@", error);
+        return NO;
+    }
+    
+    NSString *name = destLocation.path.lastPathComponent;
+    if (hash) {
+        NSDictionary *attribute = [fm attributesOfItemAtPath:destLocation.path error:nil];
+        self.manifest[name] = @{@"hash":hash,
+                                @"size":attribute[NSFileSize],
+                                @"mtime":@([attribute[NSFileModificationDate] timeIntervalSince1970])};
+    } else {
+        [self.manifest removeObjectForKey:name];
+    }
+    [self saveManifest];
+    return YES;
+}
+
+static BOOL readVarint(const uint8_t *bytes, NSUInteger length, NSUInteger *pos, uint64_t *value)
+{
+    uint64_t v = 0;
+    for(int shift = 0; shift < 64 && *pos < length; shift += 7) {
+        uint8_t b = bytes[(*pos)++];
+        v |= (uint64_t)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+            *value = v;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (BOOL) applyPatch:(NSURL*)patchURL toFile:(NSURL*)baseURL output:(NSURL*)outURL
+{
+    NSData *patch = [NSData dataWithContentsOfURL:patchURL options:NSDataReadingMappedIfSafe error:nil];
+    NSData *base = [NSData dataWithContentsOfURL:baseURL options:NSDataReadingMappedIfSafe error:nil];
+    if (!patch || !base || patch.length < 5 || memcmp(patch.bytes, PATCH_MAGIC, 4) != 0) {
+        return NO;
+    }
+    const uint8_t *p = patch.bytes;
+    NSUInteger plen = patch.length, pos = 4;
+    if (p[pos++] != PATCH_VERSION) {
+        return NO;
+    }
+    
+    NSOutputStream *out = [NSOutputStream outputStreamWithURL:outURL append:NO];
+    [out open];
+    BOOL (^write)(const uint8_t*, uint64_t) = ^(const uint8_t *bytes, uint64_t len) {
+        while(len > 0) {
+            NSInteger w = [out write:bytes maxLength:(NSUInteger)MIN(len, 64*1024)];
+            if (w <= 0) {
+                return NO;
+            }
+            bytes += w;
+            len -= w;
+        }
+        return YES;
+    };
+    
+    BOOL ok = NO;
+    while(pos < plen) {
+        uint8_t op = p[pos++];
+        uint64_t offset = 0, length = 0;
+        if (op == PATCH_OP_END) {
+            ok = (pos == plen);
+            break;
+        } else if (op == PATCH_OP_COPY) {
+            if (!readVarint(p, plen, &pos, &offset) || !readVarint(p, plen, &pos, &length) ||
+                offset > base.length || length > base.length - offset ||
+                !write((const uint8_t*)base.bytes + offset, length)) {
+                break;
+            }
+        } else if (op == PATCH_OP_ADD) {
+            if (!readVarint(p, plen, &pos, &length) || length > plen - pos ||
+                !write(p + pos, length)) {
+                break;
+            }
+            pos += length;
+        } else {
+            break;
+        }
+    }
+    [out close];
+    return ok;
+}
+
 - (void)checkAgreementForIdentifier:(NSString*)identifier withCompletion:(void(^)(NSDictionary*))complete
 {
     if (self.selected.noCheckAgreement) {
@@ -24,6 +24,7 @@
 #import "LocationEvent.h"
 #import "NavDebugHelper.h"
 #import "NavUtil.h"
+#import "NavCoalescer.h"
 #import "NavDataStore.h"
 #import "RatingViewController.h"
 #import "SettingViewController.h"
@@ -53,6 +54,7 @@ typedef NS_ENUM(NSInteger, ViewState) {
     
     NSTimeInterval lastLocationSent;
     NSTimeInterval lastOrientationSent;
+    NavLatestCoalescer *locationCoalescer;
 }
 
 @end
@@ -124,6 +126,10 @@ typedef NS_ENUM(NSInteger, ViewState) {
     
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(locationStatusChanged:) name:NAV_LOCATION_STATUS_CHANGE object:nil];
 
+    __weak typeof(self) weakself = self;
+    locationCoalescer = [[NavLatestCoalescer alloc] initWithQueue:[NSOperationQueue mainQueue] handler:^(id note, long dropped) {
+        [weakself latestLocationChanged:note];
+    }];
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(locationChanged:) name:NAV_LOCATION_CHANGED_NOTIFICATION object:nil];
     
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(openURL:) name: REQUEST_OPEN_URL object:nil];
@@ -566,71 +572,74 @@ typedef NS_ENUM(NSInteger, ViewState) {
     });
 }
 
-- (void) locationChanged: (NSNotification*) note
+- (void) locationChanged:(NSNotification*)note
 {
-    dispatch_async(dispatch_get_main_queue(), ^{
-        UIApplicationState appState = [[UIApplication sharedApplication] applicationState];
-        if (appState == UIApplicationStateBackground || appState == UIApplicationStateInactive) {
-            return;
-        }
-        
-        NSDictionary *locations = [note userInfo];
-        if (!locations) {
-            return;
-        }
-        HLPLocation *location = locations[@"current"];
-        if (!location || [location isEqual:[NSNull null]]) {
-            return;
-        }
-        
-        NSTimeInterval now = [[NSDate date] timeIntervalSince1970];
-        
-        double orientation = -location.orientation / 180 * M_PI;
-        
-        if (lastOrientationSent + 0.2 < now) {
-            [_webView sendData:@[@{
-                                     @"type":@"ORIENTATION",
-                                     @"z":@(orientation)
-                                     }]
-                      withName:@"Sensor"];
-            lastOrientationSent = now;
-        }
-        
-        
-        location = locations[@"actual"];
-        if (!location || [location isEqual:[NSNull null]]) {
+    [locationCoalescer submit:note];
+}
+
+- (void) latestLocationChanged:(NSNotification*)note
+{
+    UIApplicationState appState = [[UIApplication sharedApplication] applicationState];
+    if (appState == UIApplicationStateBackground || appState == UIApplicationStateInactive) {
+        return;
+    }
+    
+    NSDictionary *locations = [note userInfo];
+    if (!locations) {
+        return;
+    }
+    HLPLocation *location = locations[@"current"];
+    if (!location || [location isEqual:[NSNull null]]) {
+        return;
+    }
+    
+    NSTimeInterval now = [[NSDate date] timeIntervalSince1970];
+    
+    double orientation = -location.orientation / 180 * M_PI;
+    
+    if (lastOrientationSent + 0.2 < now) {
+        [_webView sendData:@[@{
+                                 @"type":@"ORIENTATION",
+                                 @"z":@(orientation)
+                                 }]
+                  withName:@"Sensor"];
+        lastOrientationSent = now;
+    }
+    
+    
+    location = locations[@"actual"];
+    if (!location || [location isEqual:[NSNull null]]) {
+        return;
+    }
+    
+    /*
+     if (isnan(location.lat) || isnan(location.lng)) {
+     return;
+     }
+     */
+    
+    if (now < lastLocationSent + [[NSUserDefaults standardUserDefaults] doubleForKey:@"webview_update_min_interval"]) {
+        if (!location.params) {
             return;
         }
-        
-        /*
-         if (isnan(location.lat) || isnan(location.lng)) {
-         return;
-         }
-         */
-        
-        if (now < lastLocationSent + [[NSUserDefaults standardUserDefaults] doubleForKey:@"webview_update_min_interval"]) {
-            if (!location.params) {
-                return;
-            }
-            //return; // prevent too much send location info
-        }
-        
-        double floor = location.floor;
-        
-        [_webView sendData:@{
-                             @"lat":@(location.lat),
-                             @"lng":@(location.lng),
-                             @"floor":@(floor),
-                             @"accuracy":@(location.accuracy),
-                             @"rotate":@(0), // dummy
-                             @"orientation":@(999), //dummy
-                             @"debug_info":location.params?location.params[@"debug_info"]:[NSNull null],
-                             @"debug_latlng":location.params?location.params[@"debug_latlng"]:[NSNull null]
-                             }
-                  withName:@"XYZ"];
-        
-        lastLocationSent = now;
-    });
+        //return; // prevent too much send location info
+    }
+    
+    double floor = location.floor;
+    
+    [_webView sendData:@{
+                         @"lat":@(location.lat),
+                         @"lng":@(location.lng),
+                         @"floor":@(floor),
+                         @"accuracy":@(location.accuracy),
+                         @"rotate":@(0), // dummy
+                         @"orientation":@(999), //dummy
+                         @"debug_info":location.params?location.params[@"debug_info"]:[NSNull null],
+                         @"debug_latlng":location.params?location.params[@"debug_latlng"]:[NSNull null]
+                         }
+              withName:@"XYZ"];
+    
+    lastLocationSent = now;
 }
 
 - (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary<NSString *,id> *)change context:(void *)context
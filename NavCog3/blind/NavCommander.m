@@ -21,9 +21,9 @@
  *******************************************************************************/
 
 #import "NavCommander.h"
-#import <FormatterKit/TTTOrdinalNumberFormatter.h>
 #import "NavDataStore.h"
 #import "LocationEvent.h"
+#import "NavStrings.h"
 
 @implementation NavCommander {
     NSTimeInterval lastPOIAnnounceTime;
@@ -48,34 +48,29 @@
 
 - (NSString*) floorString:(double) floor
 {
-    NSString *type = NSLocalizedStringFromTable(@"FloorNumType", @"BlindView", @"floor num type");
+    NSString *type = NavLocalizedStringFromTable(@"FloorNumType", @"BlindView", @"floor num type");
     
     if ([type isEqualToString:@"ordinal"]) {
-        TTTOrdinalNumberFormatter*ordinalNumberFormatter = [[TTTOrdinalNumberFormatter alloc] init];
-        
         NSString *localeStr = [[NSUserDefaults standardUserDefaults] stringForKey:@"AppleLocale"];
-        NSLocale *locale = [NSLocale localeWithLocaleIdentifier:localeStr];
-        [ordinalNumberFormatter setLocale:locale];
-        [ordinalNumberFormatter setGrammaticalGender:TTTOrdinalNumberFormatterMaleGender];
         
         floor = round(floor*2.0)/2.0;
         
         if (floor < 0) {
-            NSString *ordinalNumber = [ordinalNumberFormatter stringFromNumber:@(fabs(floor))];
+            NSString *ordinalNumber = NavOrdinalNumberString(@(fabs(floor)), localeStr);
             
-            return [NSString localizedStringWithFormat:NSLocalizedStringFromTable(@"FloorBasementD", @"BlindView", @"basement floor"), ordinalNumber];
+            return [NSString localizedStringWithFormat:NavLocalizedStringFromTable(@"FloorBasementD", @"BlindView", @"basement floor"), ordinalNumber];
         } else {
-            NSString *ordinalNumber = [ordinalNumberFormatter stringFromNumber:@(floor+1)];
+            NSString *ordinalNumber = NavOrdinalNumberString(@(floor+1), localeStr);
             
-            return [NSString localizedStringWithFormat:NSLocalizedStringFromTable(@"FloorD", @"BlindView", @"floor"), ordinalNumber];
+            return [NSString localizedStringWithFormat:NavLocalizedStringFromTable(@"FloorD", @"BlindView", @"floor"), ordinalNumber];
         }
     } else {
         floor = round(floor*2.0)/2.0;
         
         if (floor < 0) {
-            return [NSString localizedStringWithFormat:NSLocalizedStringFromTable(@"FloorBasementD", @"BlindView", @"basement floor"), @(fabs(floor))];
+            return [NSString localizedStringWithFormat:NavLocalizedStringFromTable(@"FloorBasementD", @"BlindView", @"basement floor"), @(fabs(floor))];
         } else {
-            return [NSString localizedStringWithFormat:NSLocalizedStringFromTable(@"FloorD", @"BlindView", @"floor"), @(floor+1)];
+            return [NSString localizedStringWithFormat:NavLocalizedStringFromTable(@"FloorD", @"BlindView", @"floor"), @(floor+1)];
         }
     }
 }
@@ -101,7 +96,7 @@
         distance = floor(distance / 5.0) * 5.0;
     }
     NSString *unit = isFeet?@"unit_feet":@"unit_meter";
-    return [NSString stringWithFormat:NSLocalizedStringFromTable(unit, @"BlindView", @""), (int)round(distance)];
+    return [NSString stringWithFormat:NavLocalizedStringFromTable(unit, @"BlindView", @""), (int)round(distance)];
 }
 
 - (NSString*)actionString:(NSDictionary*)properties
@@ -119,23 +114,23 @@
     NSString *string = nil;
     
     if (turnAngle < -150 ) {
-        string = NSLocalizedStringFromTable(@"make a u-turn to the left",@"BlindView", @"make turn to -180 ~ -180");
+        string = NavLocalizedStringFromTable(@"make a u-turn to the left", @"BlindView", @"make turn to -180 ~ -180");
     } else if (turnAngle > 150) {
-        string = NSLocalizedStringFromTable(@"make a u-turn to the right",@"BlindView", @"make turn to +150 ~ +180");
+        string = NavLocalizedStringFromTable(@"make a u-turn to the right", @"BlindView", @"make turn to +150 ~ +180");
     } else if (turnAngle < -120) {
-        string = NSLocalizedStringFromTable(@"make a big left turn",@"BlindView", @"make turn to -120 ~ -150");
+        string = NavLocalizedStringFromTable(@"make a big left turn", @"BlindView", @"make turn to -120 ~ -150");
     } else if (turnAngle > 120) {
-        string = NSLocalizedStringFromTable(@"make a big right turn",@"BlindView", @"make turn to +120 ~ +150");
+        string = NavLocalizedStringFromTable(@"make a big right turn", @"BlindView", @"make turn to +120 ~ +150");
     } else if (turnAngle < -60) {
-        string = NSLocalizedStringFromTable(@"turn left",@"BlindView", @"make turn to -60 ~ -120");
+        string = NavLocalizedStringFromTable(@"turn left", @"BlindView", @"make turn to -60 ~ -120");
     } else if (turnAngle > 60) {
-        string = NSLocalizedStringFromTable(@"turn right",@"BlindView", @"make turn to +60 ~ +120");
+        string = NavLocalizedStringFromTable(@"turn right", @"BlindView", @"make turn to +60 ~ +120");
     } else if (turnAngle < -22.5) {
-        string = NSLocalizedStringFromTable(@"make a slight left turn",@"BlindView", @"make turn to -22.5 ~ -60");
+        string = NavLocalizedStringFromTable(@"make a slight left turn", @"BlindView", @"make turn to -22.5 ~ -60");
     } else if (turnAngle > 22.5) {
-        string = NSLocalizedStringFromTable(@"make a slight right turn",@"BlindView", @"make turn to +22.5 ~ +60");
+        string = NavLocalizedStringFromTable(@"make a slight right turn", @"BlindView", @"make turn to +22.5 ~ +60");
     } else {
-        string = NSLocalizedStringFromTable(@"go straight", @"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"go straight", @"BlindView", @"");
     }
     
     NSArray *pois = properties[@"pois"];
@@ -153,7 +148,7 @@
     if (isCornerEnd) {
         formatString = [formatString stringByAppendingString:@" at end object"];
     }
-    formatString = NSLocalizedStringFromTable(formatString, @"BlindView", @"");
+    formatString = NavLocalizedStringFromTable(formatString, @"BlindView", @"");
     string = [NSString stringWithFormat:formatString, string, cornerInfo];
     
 
@@ -165,23 +160,23 @@
         
         NSString *angle;
         if (turnAngle < -150) {
-            angle = NSLocalizedStringFromTable(@"on your left side(almost back)",@"BlindView", @"something at your degree -150 ~ -180"); //@"左後ろ";
+            angle = NavLocalizedStringFromTable(@"on your left side(almost back)", @"BlindView", @"something at your degree -150 ~ -180"); //@"左後ろ";
         } else if (turnAngle > 150) {
-            angle = NSLocalizedStringFromTable(@"on your right side(almost back)",@"BlindView", @"something at your degree +150 ~ +180"); //@"右後ろ";
+            angle = NavLocalizedStringFromTable(@"on your right side(almost back)", @"BlindView", @"something at your degree +150 ~ +180"); //@"右後ろ";
         } else if (turnAngle < -135) {
-            angle = NSLocalizedStringFromTable(@"on your left side(back)",@"BlindView", @"something at your degree -120 ~ -150"); //@"左斜め後ろ";
+            angle = NavLocalizedStringFromTable(@"on your left side(back)", @"BlindView", @"something at your degree -120 ~ -150"); //@"左斜め後ろ";
         } else if (turnAngle > 135) {
-            angle = NSLocalizedStringFromTable(@"on your right side(back)",@"BlindView", @"something at your degree +120 ~ +150"); //@"右斜め後ろ";
+            angle = NavLocalizedStringFromTable(@"on your right side(back)", @"BlindView", @"something at your degree +120 ~ +150"); //@"右斜め後ろ";
         } else if (turnAngle < -45) {
-            angle = NSLocalizedStringFromTable(@"on your left side",@"BlindView", @"something at your degree -60 ~ -120"); //@"左";
+            angle = NavLocalizedStringFromTable(@"on your left side", @"BlindView", @"something at your degree -60 ~ -120"); //@"左";
         } else if (turnAngle > 45) {
-            angle = NSLocalizedStringFromTable(@"on your right side",@"BlindView", @"something at your degree +60 ~ +120"); //@"右";
+            angle = NavLocalizedStringFromTable(@"on your right side", @"BlindView", @"something at your degree +60 ~ +120"); //@"右";
         //} else if (turnAngle < -22.5) {
         //    angle = NSLocalizedStringFromTable(@"on your left side(front)",@"BlindView", @"something at your degree -22.5 ~ -60"); //@"左斜め前";
         //} else if (turnAngle > 22.5) {
         //    angle = NSLocalizedStringFromTable(@"on your right side(front)",@"BlindView", @"something at your degree +22.5 ~ +60"); //@"右斜め前";
         } else {
-            angle = NSLocalizedStringFromTable(@"in front of you",@"BlindView", @"something at your degree -22.5 ~ +22.5"); //@"正面";
+            angle = NavLocalizedStringFromTable(@"in front of you", @"BlindView", @"something at your degree -22.5 ~ +22.5"); //@"正面";
         }
         
         BOOL full = [properties[@"fullAction"] boolValue];
@@ -206,14 +201,14 @@
             } else if (right) {
                 side = @"LeftSide";
             }
-            side = NSLocalizedStringFromTable(side, @"BlindView", @"");
+            side = NavLocalizedStringFromTable(side, @"BlindView", @"");
 
             NSString *tfloor = [self floorString:targetHeight];
             NSString *format = fabs(sourceHeight - targetHeight) < 0.1 ? @"FloorChangeActionString3": @"FloorChangeActionString4";
             format = [format stringByAppendingString:up?@"Up":@"Down"];
             
-            string = [NSString stringWithFormat:NSLocalizedStringFromTable(format,@"BlindView",@"") , angle, side, mean, tfloor];//@""
-            string = [string stringByAppendingString:NSLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
+            string = [NSString stringWithFormat:NavLocalizedStringFromTable(format, @"BlindView", @"") , angle, side, mean, tfloor];//@""
+            string = [string stringByAppendingString:NavLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
             
             if (nextLinkType == LINK_TYPE_ESCALATOR && [flags count] > 0) {
                 NSString *format;
@@ -231,8 +226,8 @@
                     if (flag.backward) {
                         format = [format stringByAppendingString:@"Backward"];
                     }
-                    string = [string stringByAppendingString:NSLocalizedStringFromTable(format, @"BlindView", @"")];
-                    string = [string stringByAppendingString:NSLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
+                    string = [string stringByAppendingString:NavLocalizedStringFromTable(format, @"BlindView", @"")];
+                    string = [string stringByAppendingString:NavLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
                 }
             }
         }
@@ -251,16 +246,16 @@
         if (full) {
             NSString *format = @"FloorChangeDoneActionString2";
             format = [format stringByAppendingString:up?@"Up":@"Down"];
-            string = [NSString stringWithFormat:NSLocalizedStringFromTable(format,@"BlindView",@"") , mean, string];
+            string = [NSString stringWithFormat:NavLocalizedStringFromTable(format, @"BlindView", @"") , mean, string];
         } else {
             NSString *format = fabs(sourceHeight - targetHeight) < 0.1 ? @"FloorChangeActionString1" : @"FloorChangeActionString2";
             format = [format stringByAppendingString:up?@"Up":@"Down"];
-            string = [NSString stringWithFormat:NSLocalizedStringFromTable(format,@"BlindView",@"") , mean, tfloor];
+            string = [NSString stringWithFormat:NavLocalizedStringFromTable(format, @"BlindView", @"") , mean, tfloor];
         }
     }
     else {
         if (linkType == LINK_TYPE_ELEVATOR) {
-            string = [NSString stringWithFormat:NSLocalizedStringFromTable(@"After getting off the elevator, %@", @"BlindView", @""), string];
+            string = [NSString stringWithFormat:NavLocalizedStringFromTable(@"After getting off the elevator, %@", @"BlindView", @""), string];
         }
     }
     return string;
@@ -274,18 +269,18 @@
     format = [format stringByAppendingString:(poi.count == 1)?@"1":@"2"];
     format = [format stringByAppendingString:(shortSentence)?@"Short":@""];
     
-    return [NSString stringWithFormat:NSLocalizedStringFromTable(format, @"BlindView", @""), poi.count];
+    return [NSString stringWithFormat:NavLocalizedStringFromTable(format, @"BlindView", @""), poi.count];
 }
 
 - (NSString*) obstacleString:(NavPOI*)poi withOption:option
 {
     NSString *side = nil;
     if (poi.leftSide && poi.rightSide) {
-        side = NSLocalizedStringFromTable(@"BothSide", @"BlindView", @"");
+        side = NavLocalizedStringFromTable(@"BothSide", @"BlindView", @"");
     } else if (poi.leftSide) {
-        side = NSLocalizedStringFromTable(@"LeftSide", @"BlindView", @"");
+        side = NavLocalizedStringFromTable(@"LeftSide", @"BlindView", @"");
     } else if (poi.rightSide) {
-        side = NSLocalizedStringFromTable(@"RightSide", @"BlindView", @"");
+        side = NavLocalizedStringFromTable(@"RightSide", @"BlindView", @"");
     }
     
     BOOL shortSentence = option && option[@"short"] && [option[@"short"] boolValue];
@@ -294,7 +289,7 @@
         NSString *format = @"ObstaclePOIString";
         format = [format stringByAppendingString:(poi.count == 1)?@"1":@"2"];
         format = [format stringByAppendingString:(shortSentence)?@"Short":@""];
-        return [NSString stringWithFormat:NSLocalizedStringFromTable(format, @"BlindView", @""), side];
+        return [NSString stringWithFormat:NavLocalizedStringFromTable(format, @"BlindView", @""), side];
     }
     
     return nil;
@@ -306,7 +301,7 @@
     NSString *format = @"RampPOIString";
     format = [format stringByAppendingString:(shortSentence)?@"Short":@""];
     
-    return NSLocalizedStringFromTable(format, @"BlindView", @"");
+    return NavLocalizedStringFromTable(format, @"BlindView", @"");
 }
 
 - (NSString*) brailleBlockString:(NavPOI*)poi withOption:option
@@ -316,7 +311,7 @@
     format = [poi.flagEnd?@"No":@"" stringByAppendingString:format];
     format = [format stringByAppendingString:(shortSentence)?@"Short":@""];
     
-    return NSLocalizedStringFromTable(format, @"BlindView", @"");
+    return NavLocalizedStringFromTable(format, @"BlindView", @"");
 }
 
 - (NSString*) poiString:(NavPOI*) poi
@@ -333,11 +328,11 @@
     NSMutableString *string = [@"" mutableCopy];
     if (poi.forFloor) {
         if (poi.flagCaution) {
-            [string appendFormat:NSLocalizedStringFromTable(@"Watch your step, %@", @"BlindView", @""), poi.text];
+            [string appendFormat:NavLocalizedStringFromTable(@"Watch your step, %@", @"BlindView", @""), poi.text];
         }
     }
     else if (poi.forSign) {
-        [string appendFormat:NSLocalizedStringFromTable(@"There is a sign says %@", @"BlindView", @""), poi.text];
+        [string appendFormat:NavLocalizedStringFromTable(@"There is a sign says %@", @"BlindView", @""), poi.text];
     }
     else if (poi.forDoor) {
         [string appendString:[self doorString:poi withOption:option]];
@@ -358,12 +353,12 @@
         }
         if (poi.longDescription) {
             if ([temp length] > 0) {
-                temp = [temp stringByAppendingString:NSLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
+                temp = [temp stringByAppendingString:NavLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
             }
             temp = [temp stringByAppendingString:poi.longDescription];
         }
         if (poi.flagCaution) {
-            temp = [NSString stringWithFormat:NSLocalizedStringFromTable(@"Caution, %@", @"BlindView", @""), temp];
+            temp = [NSString stringWithFormat:NavLocalizedStringFromTable(@"Caution, %@", @"BlindView", @""), temp];
         }
         [string appendString:temp];
     }
@@ -379,7 +374,7 @@
     pois = [pois filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"forWelcome == YES"]];
     for(NavPOI *poi in pois) {
         [string appendString:[self poiString:poi]];
-        [string appendString:NSLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
+        [string appendString:NavLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
     }
     return string;
 }
@@ -397,12 +392,12 @@
         NSArray *infos = [pois filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"flagCaution == NO"]];
         for(NavPOI *poi in infos) {
             [string appendString:[self poiString:poi]];
-            [string appendString:NSLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
+            [string appendString:NavLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
         }
         NSArray *cautions = [pois filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"flagCaution == YES"]];
         for(NavPOI *poi in cautions) {
             [string appendString:[self poiString:poi]];
-            [string appendString:NSLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
+            [string appendString:NavLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
         }
     }
     
@@ -420,7 +415,7 @@
     if ([pois count] > 0) {
         NavPOI *poi = pois[0];
         if (poi.forBrailleBlock) {
-            text = NSLocalizedStringFromTable(@"BrailleBlock", @"BlindView", @"");
+            text = NavLocalizedStringFromTable(@"BrailleBlock", @"BlindView", @"");
         } else {
             if (poi.text && [poi.text length] > 0) {
                 text = poi.text;
@@ -467,33 +462,33 @@
     NSString *string;
     if (looseDirection) {
         if (diffHeading < -135 || 135 < diffHeading) {
-            string = NSLocalizedStringFromTable(@"turn around",@"BlindView", @"head to the back");
+            string = NavLocalizedStringFromTable(@"turn around", @"BlindView", @"head to the back");
         } else if (diffHeading < -67.5) {
-            string = NSLocalizedStringFromTable(@"turn to the left",@"BlindView", @"head to the left direction");
+            string = NavLocalizedStringFromTable(@"turn to the left", @"BlindView", @"head to the left direction");
         } else if (diffHeading > 67.5) {
-            string = NSLocalizedStringFromTable(@"turn to the right",@"BlindView", @"head to the right direction");
+            string = NavLocalizedStringFromTable(@"turn to the right", @"BlindView", @"head to the right direction");
         } else if (diffHeading < -threshold) {
-            string = NSLocalizedStringFromTable(@"bear left",@"BlindView", @"head to the diagonally forward left direction");
+            string = NavLocalizedStringFromTable(@"bear left", @"BlindView", @"head to the diagonally forward left direction");
         } else if (diffHeading > threshold) {
-            string = NSLocalizedStringFromTable(@"bear right",@"BlindView", @"head to the diagonally forward right direction");
+            string = NavLocalizedStringFromTable(@"bear right", @"BlindView", @"head to the diagonally forward right direction");
         } else {
             return nil;
         }
     } else {
         if (diffHeading < -150 || 150 < diffHeading) {
-            string = NSLocalizedStringFromTable(@"turn around",@"BlindView", @"head to the back");
+            string = NavLocalizedStringFromTable(@"turn around", @"BlindView", @"head to the back");
         } else if (diffHeading < -120) {
-            string = NSLocalizedStringFromTable(@"turn to the backward left",@"BlindView", @"head to the diagonally backward left direction");
+            string = NavLocalizedStringFromTable(@"turn to the backward left", @"BlindView", @"head to the diagonally backward left direction");
         } else if (diffHeading > 120) {
-            string = NSLocalizedStringFromTable(@"turn to the backward right",@"BlindView", @"head to the diagonally backward right direction");
+            string = NavLocalizedStringFromTable(@"turn to the backward right", @"BlindView", @"head to the diagonally backward right direction");
         } else if (diffHeading < -60) {
-            string = NSLocalizedStringFromTable(@"turn to the left",@"BlindView", @"head to the left direction");
+            string = NavLocalizedStringFromTable(@"turn to the left", @"BlindView", @"head to the left direction");
         } else if (diffHeading > 60) {
-            string = NSLocalizedStringFromTable(@"turn to the right",@"BlindView", @"head to the right direction");
+            string = NavLocalizedStringFromTable(@"turn to the right", @"BlindView", @"head to the right direction");
         } else if (diffHeading < -threshold) {
-            string = NSLocalizedStringFromTable(@"turn slightly to the left",@"BlindView", @"head to the diagonally forward left direction");
+            string = NavLocalizedStringFromTable(@"turn slightly to the left", @"BlindView", @"head to the diagonally forward left direction");
         } else if (diffHeading > threshold) {
-            string = NSLocalizedStringFromTable(@"turn slightly to the right",@"BlindView", @"head to the diagonally forward right direction");
+            string = NavLocalizedStringFromTable(@"turn slightly to the right", @"BlindView", @"head to the diagonally forward right direction");
         } else {
             //@throw [[NSException alloc] initWithName:@"wrong parameters" reason:@"abs(diffHeading) is smaller than threshold" userInfo:nil];
             return nil;
@@ -509,21 +504,21 @@
     NSString *string = nil;
     
     if (diffHeading < -157.5 || 157.5 < diffHeading) {
-        string = NSLocalizedStringFromTable(@"BACK_DIRECTION",@"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"BACK_DIRECTION", @"BlindView", @"");
     } else if (diffHeading < -112.5) {
-        string = NSLocalizedStringFromTable(@"LEFT_BACK_DIRECTION",@"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"LEFT_BACK_DIRECTION", @"BlindView", @"");
     } else if (diffHeading > 112.5) {
-        string = NSLocalizedStringFromTable(@"RIGHT_BACK_DIRECTION",@"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"RIGHT_BACK_DIRECTION", @"BlindView", @"");
     } else if (diffHeading < -67.5) {
-        string = NSLocalizedStringFromTable(@"LEFT_DIRECTION",@"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"LEFT_DIRECTION", @"BlindView", @"");
     } else if (diffHeading > 67.5) {
-        string = NSLocalizedStringFromTable(@"RIGHT_DIRECTION",@"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"RIGHT_DIRECTION", @"BlindView", @"");
     } else if (diffHeading < -22.5) {
-        string = NSLocalizedStringFromTable(@"LEFT_FRONT_DIRECTION",@"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"LEFT_FRONT_DIRECTION", @"BlindView", @"");
     } else if (diffHeading > 22.5) {
-        string = NSLocalizedStringFromTable(@"RIGHT_FRONT_DIRECTION",@"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"RIGHT_FRONT_DIRECTION", @"BlindView", @"");
     } else {
-        string = NSLocalizedStringFromTable(@"FRONT_DIRECTION",@"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"FRONT_DIRECTION", @"BlindView", @"");
     }
     return string;
 }
@@ -555,9 +550,9 @@
     [string appendString:[self welcomePOIString:pois]];
     
     if (destination && ![destination isEqual:[NSNull null]] && [destination length] > 0){
-        [string appendFormat:NSLocalizedStringFromTable(@"distance to %1$@", @"BlindView", @"distance to a destination name"), destination, totalDist];
+        [string appendFormat:NavLocalizedStringFromTable(@"distance to %1$@", @"BlindView", @"distance to a destination name"), destination, totalDist];
     } else {
-        [string appendFormat:NSLocalizedStringFromTable(@"distance to the destination", @"BlindView", @"distance to the destination"), totalDist];
+        [string appendFormat:NavLocalizedStringFromTable(@"distance to the destination", @"BlindView", @"distance to the destination"), totalDist];
     }
     
     [_delegate speak:string withOptions:properties completionHandler:^{}];
@@ -574,9 +569,9 @@
     
     NSMutableString *string = [[NSMutableString alloc] init];
     if (destination && ![destination isEqual:[NSNull null]] && [destination length] > 0){
-        [string appendFormat:NSLocalizedStringFromTable(@"You arrived at %1$@",@"BlindView", @"arrived message with destination name"), destination];
+        [string appendFormat:NavLocalizedStringFromTable(@"You arrived at %1$@", @"BlindView", @"arrived message with destination name"), destination];
     } else {
-        [string appendFormat:NSLocalizedStringFromTable(@"You arrived",@"BlindView", @"arrived message")];
+        [string appendFormat:NavLocalizedStringFromTable(@"You arrived", @"BlindView", @"arrived message")];
     }
     
     NSArray *destPois = [properties[@"pois"] filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"forAfterEnd == YES AND isDestination == YES"]];
@@ -628,7 +623,7 @@
     if (target) {
         NSLog(@"%@", NSStringFromSelector(_cmd));
         NSString *dist = [self distanceString:distance];
-        NSString *string = [NSString stringWithFormat:NSLocalizedStringFromTable(@"remaining distance",@"BlindView", @""),  dist];
+        NSString *string = [NSString stringWithFormat:NavLocalizedStringFromTable(@"remaining distance", @"BlindView", @""),  dist];
         [_delegate speak:string withOptions:properties completionHandler:^{}];
     }
 }
@@ -640,9 +635,9 @@
     NSString *string = nil;
     
     if (false && action) {
-        string = [NSString stringWithFormat:NSLocalizedStringFromTable(@"approaching to %@",@"BlindView",@"approaching to do something") , action];
+        string = [NSString stringWithFormat:NavLocalizedStringFromTable(@"approaching to %@", @"BlindView", @"approaching to do something") , action];
     } else {
-        string = NSLocalizedStringFromTable(@"approaching",@"BlindView",@"approaching");
+        string = NavLocalizedStringFromTable(@"approaching", @"BlindView", @"approaching");
     }
     properties = [properties mtl_dictionaryByAddingEntriesFromDictionary:@{@"force":@(YES)}];
     [_delegate speak:string withOptions:properties completionHandler:^{}];
@@ -708,7 +703,7 @@
     else if (isNextDestination) {
         NSString *destTitle = [NavDataStore sharedDataStore].to.namePron;
         
-        [string appendString: [NSString stringWithFormat:NSLocalizedStringFromTable(@"destination is in distance",@"BlindView",@"remaining distance to the destination"), destTitle, dist]];
+        [string appendString: [NSString stringWithFormat:NavLocalizedStringFromTable(@"destination is in distance", @"BlindView", @"remaining distance to the destination"), destTitle, dist]];
         
         // TODO braille block is not handled
         // TODO no destTitle
@@ -727,9 +722,9 @@
             proceedString = [proceedString stringByAppendingString:@" ..."];
         }
 
-        proceedString = NSLocalizedStringFromTable(proceedString, @"BlindView", @"");
+        proceedString = NavLocalizedStringFromTable(proceedString, @"BlindView", @"");
         proceedString = [NSString stringWithFormat:proceedString, dist, floorInfo];
-        nextActionString = NSLocalizedStringFromTable(nextActionString, @"BlindView", @"");
+        nextActionString = NavLocalizedStringFromTable(nextActionString, @"BlindView", @"");
         nextActionString = [NSString stringWithFormat:nextActionString, action];
         
         [string appendString:proceedString];
@@ -744,7 +739,7 @@
 {
     NavPOI *poi = properties[@"poi"];
     NSString *floor = [self floorString:[properties[@"nextSourceHeight"] doubleValue]];
-    NSString *string = [NSString stringWithFormat:NSLocalizedStringFromTable(@"Go to %1$@", @"BlindView", @""), floor];
+    NSString *string = [NSString stringWithFormat:NavLocalizedStringFromTable(@"Go to %1$@", @"BlindView", @""), floor];
     
     if (poi) {
         string = [string stringByAppendingString:poi.text];
@@ -761,7 +756,7 @@
     NSString *hAction = [self headingActionString:properties];
     
     if (hAction) {
-        NSString *string = NSLocalizedStringFromTable(@"%@, you might be going backward.", @"BlindView", @"");
+        NSString *string = NavLocalizedStringFromTable(@"%@, you might be going backward.", @"BlindView", @"");
         string = [NSString stringWithFormat:string, hAction];
         [_delegate speak:string withOptions:properties completionHandler:^{}];
     }
@@ -775,7 +770,7 @@
     NSString *hAction = [self headingActionString:properties];
     
     if (hAction) {
-        NSString *string = NSLocalizedStringFromTable(@"%@, you might be going wrong direction.", @"BlindView", @"");
+        NSString *string = NavLocalizedStringFromTable(@"%@, you might be going wrong direction.", @"BlindView", @"");
         string = [NSString stringWithFormat:string, hAction];
         [_delegate speak:string withOptions:properties completionHandler:^{}];
     }
@@ -826,11 +821,11 @@
         NSString *angle;
         if (!isnan(heading)) {
             if (heading < -30) {
-                angle = NSLocalizedStringFromTable(@"on your left side",@"BlindView", @""); //@"左";
+                angle = NavLocalizedStringFromTable(@"on your left side", @"BlindView", @""); //@"左";
             } else if (heading > 30) {
-                angle = NSLocalizedStringFromTable(@"on your right side",@"BlindView", @""); //@"右";
+                angle = NavLocalizedStringFromTable(@"on your right side", @"BlindView", @""); //@"右";
             } else {
-                angle = NSLocalizedStringFromTable(@"in front of you",@"BlindView", @""); //@"正面";
+                angle = NavLocalizedStringFromTable(@"in front of you", @"BlindView", @""); //@"正面";
             }
         }
         
@@ -841,19 +836,19 @@
         NSMutableString *string = [@"" mutableCopy];
         if (angle && (poi.text || text)) {
             if (poi.isDestination) {
-                [string appendFormat:NSLocalizedStringFromTable(@"destination is %@", @"BlindView", @""), text, angle];
+                [string appendFormat:NavLocalizedStringFromTable(@"destination is %@", @"BlindView", @""), text, angle];
                 /*if (poi.text) {
-                    [string appendString:NSLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
+                    [string appendString:NavLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
                     [string appendString:poi.text];
                 }*/
                 isDestinationPOI = YES;
             } else {
                 if (poi.flagPlural) {
-                    [string appendFormat:NSLocalizedStringFromTable(@"poi are %@", @"BlindView", @""), text, angle];
+                    [string appendFormat:NavLocalizedStringFromTable(@"poi are %@", @"BlindView", @""), text, angle];
                 } else if (poi.flagOnomastic) {
-                    [string appendFormat:NSLocalizedStringFromTable(@"name is %@", @"BlindView", @""), text, angle];
+                    [string appendFormat:NavLocalizedStringFromTable(@"name is %@", @"BlindView", @""), text, angle];
                 } else {
-                    [string appendFormat:NSLocalizedStringFromTable(@"poi is %@", @"BlindView", @""), text, angle];
+                    [string appendFormat:NavLocalizedStringFromTable(@"poi is %@", @"BlindView", @""), text, angle];
                 }
             }
         } else {
@@ -862,7 +857,7 @@
             }
         }
         if (ld) {
-            [string appendString:NSLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
+            [string appendString:NavLocalizedStringFromTable(@"PERIOD", @"BlindView", @"")];
             [string appendString:ld];
         }
         
@@ -932,7 +927,7 @@
     else if (isNextDestination) {
         NSString *destTitle = [NavDataStore sharedDataStore].to.namePron;
         
-        [string appendString: [NSString stringWithFormat:NSLocalizedStringFromTable(@"destination is in distance",@"BlindView",@"remaining distance to the destination"), destTitle, dist]];
+        [string appendString: [NSString stringWithFormat:NavLocalizedStringFromTable(@"destination is in distance", @"BlindView", @"remaining distance to the destination"), destTitle, dist]];
     }
     else if (action) {
         NSString *proceedString = @"proceed distance";
@@ -943,9 +938,9 @@
         }
         proceedString = [proceedString stringByAppendingString:@" ..."];
         
-        proceedString = NSLocalizedStringFromTable(proceedString, @"BlindView", @"");
+        proceedString = NavLocalizedStringFromTable(proceedString, @"BlindView", @"");
         proceedString = [NSString stringWithFormat:proceedString, dist, floorInfo];
-        nextActionString = NSLocalizedStringFromTable(nextActionString, @"BlindView", @"");
+        nextActionString = NavLocalizedStringFromTable(nextActionString, @"BlindView", @"");
         nextActionString = [NSString stringWithFormat:nextActionString, action];
         
         [string appendString:proceedString];
@@ -1017,7 +1012,7 @@
     else if (isNextDestination) {
         NSString *destTitle = [NavDataStore sharedDataStore].to.namePron;
         
-        [string appendString: [NSString stringWithFormat:NSLocalizedStringFromTable(@"destination is in distance",@"BlindView",@"remaining distance to the destination"), destTitle, dist]];
+        [string appendString: [NSString stringWithFormat:NavLocalizedStringFromTable(@"destination is in distance", @"BlindView", @"remaining distance to the destination"), destTitle, dist]];
     }
     else if (action) {
         NSString *proceedString = @"proceed distance";
@@ -1029,13 +1024,13 @@
         proceedString = [proceedString stringByAppendingString:@" ..."];
         
         if (dist) {
-            proceedString = NSLocalizedStringFromTable(proceedString, @"BlindView", @"");
+            proceedString = NavLocalizedStringFromTable(proceedString, @"BlindView", @"");
             proceedString = [NSString stringWithFormat:proceedString, dist, floorInfo];
             [string appendString:proceedString];
         }
         
         if (action) {
-            nextActionString = NSLocalizedStringFromTable(nextActionString, @"BlindView", @"");
+            nextActionString = NavLocalizedStringFromTable(nextActionString, @"BlindView", @"");
             nextActionString = [NSString stringWithFormat:nextActionString, action];
             [string appendString:nextActionString];
         }
@@ -1050,7 +1045,7 @@
 {
     BOOL noLocation = [properties[@"noLocation"] boolValue];
     if (noLocation) {
-        [self.delegate speak:NSLocalizedStringFromTable(@"NO_AVAILABLE_LOCATION",@"BlindView", @"") withOptions:properties completionHandler:^{}];
+        [self.delegate speak:NavLocalizedStringFromTable(@"NO_AVAILABLE_LOCATION", @"BlindView", @"") withOptions:properties completionHandler:^{}];
 
         return;
     }
@@ -1058,13 +1053,13 @@
     double acc = [properties[@"accuracy"] doubleValue];
     NSString *string;
     if (acc > 45) {
-        string = NSLocalizedStringFromTable(@"HEADING_CALIBRATION", @"BlindView", @"");        
+        string = NavLocalizedStringFromTable(@"HEADING_CALIBRATION", @"BlindView", @"");        
     }
     else if (acc > 22.5) {
-        string = NSLocalizedStringFromTable(@"HEADING_CALIBRATION2", @"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"HEADING_CALIBRATION2", @"BlindView", @"");
     }
     else if (!silenceIfCalibrated){
-        string = NSLocalizedStringFromTable(@"HEADING_CALIBRATION3", @"BlindView", @"");
+        string = NavLocalizedStringFromTable(@"HEADING_CALIBRATION3", @"BlindView", @"");
     }
     [self.delegate vibrate];
     [self.delegate speak:string withOptions:properties completionHandler:^{}];
@@ -1072,7 +1067,7 @@
 
 -(void)reroute:(NSDictionary *)properties
 {
-    NSString *string = NSLocalizedStringFromTable(@"REROUTING", @"BlindView", @"");
+    NSString *string = NavLocalizedStringFromTable(@"REROUTING", @"BlindView", @"");
     [self.delegate vibrate];
     [self.delegate speak:string withOptions:properties completionHandler:^{}];
 }
@@ -108,10 +108,7 @@
 {
     if (!string) return @"";
     NSString *first = [[string substringWithRange:NSMakeRange(0, 1)] uppercaseString];
-    NSMutableString* retStr = [[NSMutableString alloc] initWithString:first];
-    CFStringTransform((CFMutableStringRef)retStr, NULL, kCFStringTransformHiraganaKatakana, YES);
-    first = retStr;
-    return first;
+    return HLPNormalizeKana(first);
 }
 
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView
@@ -215,6 +212,12 @@
 
 @implementation NavDestinationDataSource {
     NSArray *sections;
+    
+    // filtered destinations, reused while the destinations and the filter are unchanged
+    NSArray *cachedDestinations;
+    NSDictionary *cachedFilter;
+    NSArray<HLPLandmark*> *cachedShops;
+    NSArray<HLPLandmark*> *cachedFacilities;
 }
 
 - (instancetype) init {
@@ -229,33 +232,29 @@
     [[NSNotificationCenter defaultCenter] removeObserver:self];
 }
 
-- (void) update:(NSNotification*)note {
-    if (!_filter) {
-        _filter = _defaultFilter;
-    } else {
-        _filter = [_filter mtl_dictionaryByAddingEntriesFromDictionary:_defaultFilter];
-    }
-    
-    NSArray *all = [[[NavDataStore sharedDataStore] destinations] filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(HLPLandmark *landmark, NSDictionary<NSString *,id> * _Nullable bindings) {
+- (void) filterDestinations:(NSArray*)destinations
+{
+    NSDictionary *filter = _filter;
+    NSArray *all = [destinations filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(HLPLandmark *landmark, NSDictionary<NSString *,id> * _Nullable bindings) {
         BOOL flag = YES;
-        if (_filter) {
-            for(NSString *key in _filter.allKeys) {
-                if ([[NSNull null] isEqual:_filter[key]]) {
+        if (filter) {
+            for(NSString *key in filter.allKeys) {
+                if ([[NSNull null] isEqual:filter[key]]) {
                     flag = flag && landmark.properties[key] == nil;
-                } else if ([_filter[key] isKindOfClass:NSDictionary.class]) {
-                    NSDictionary *filter = _filter[key];
-                    if (filter[@"$not"]) {
-                        flag = flag && ![landmark.properties[key] isEqual:filter[@"$not"]];
+                } else if ([filter[key] isKindOfClass:NSDictionary.class]) {
+                    NSDictionary *op = filter[key];
+                    if (op[@"$not"]) {
+                        flag = flag && ![landmark.properties[key] isEqual:op[@"$not"]];
                     }
-                    if (filter[@"$not_contains"]) {
-                        flag = flag && ![landmark.properties[key] containsString:filter[@"$not_contains"]];
+                    if (op[@"$not_contains"]) {
+                        flag = flag && ![landmark.properties[key] containsString:op[@"$not_contains"]];
                     }
-                } else if ([_filter[key] isKindOfClass:NSString.class]) {
-                    flag = flag && ([_filter[key] isEqualToString:landmark.properties[key]] ||
-                                    ([_filter[key] isEqualToString:@""] &&
+                } else if ([filter[key] isKindOfClass:NSString.class]) {
+                    flag = flag && ([filter[key] isEqualToString:landmark.properties[key]] ||
+                                    ([filter[key] isEqualToString:@""] &&
                                      landmark.properties[key] == nil));
                 } else {
-                    flag = flag && [landmark.properties[key] isEqual:_filter[key]];
+                    flag = flag && [landmark.properties[key] isEqual:filter[key]];
                 }
             }
         }
@@ -279,6 +278,26 @@
         return [n1 compare:n2];
     }];
     
+    cachedDestinations = destinations;
+    cachedFilter = filter;
+    cachedShops = shops;
+    cachedFacilities = facilities;
+}
+
+- (void) update:(NSNotification*)note {
+    if (!_filter) {
+        _filter = _defaultFilter;
+    } else {
+        _filter = [_filter mtl_dictionaryByAddingEntriesFromDictionary:_defaultFilter];
+    }
+    
+    NSArray *destinations = [[NavDataStore sharedDataStore] destinations];
+    if (destinations != cachedDestinations || !(_filter == cachedFilter || [_filter isEqualToDictionary:cachedFilter])) {
+        [self filterDestinations:destinations];
+    }
+    NSArray *shops = cachedShops;
+    NSArray *facilities = cachedFacilities;
+    
     NSMutableArray *tempSections = [@[] mutableCopy];
     
     if (_showDialog) {
@@ -296,21 +315,35 @@
     if (_showNearShops) {
         NSMutableArray *temp = [@[] mutableCopy];
         HLPLocation *loc = [[NavDataStore sharedDataStore] currentLocation];
-        [[shops sortedArrayUsingComparator:^NSComparisonResult(HLPLandmark *obj1, HLPLandmark *obj2) {
-            NSComparisonResult r = [@(fabs(loc.floor - obj1.nodeHeight)) compare:@(fabs(loc.floor - obj2.nodeHeight))];
-            if (r == NSOrderedSame) {
-                HLPLocation *loc1 = [obj1 nearestLocationTo:loc];
-                HLPLocation *loc2 = [obj2 nearestLocationTo:loc];
-                return [@([loc1 distanceTo:loc]) compare:@([loc2 distanceTo:loc])];
+        // the five nearest shops ordered by floor difference then distance,
+        // keeping only the ones on the same floor within 25m
+        const int K = 5;
+        HLPLandmark *nearest[K];
+        double nearestFloor[K], nearestDist[K];
+        int count = 0;
+        for(HLPLandmark *obj in shops) {
+            double fd = fabs(loc.floor - obj.nodeHeight);
+            if (count == K && fd > nearestFloor[K-1]) {
+                continue;
             }
-            return r;
-        }] enumerateObjectsUsingBlock:^(HLPLandmark *obj, NSUInteger idx, BOOL * _Nonnull stop) {
-            HLPLocation *loc1 = [obj nearestLocationTo:loc];
-            double dist = [loc1 distanceTo:loc];
-            if (idx < 5 && fabs(loc.floor - obj.nodeHeight) < 0.5 && dist < 25) {
-                [temp addObject:[[NavDestination alloc] initWithLandmark:obj]];
+            double dist = [[obj nearestLocationTo:loc] distanceTo:loc];
+            int i = count;
+            while(i > 0 && (fd < nearestFloor[i-1] || (fd == nearestFloor[i-1] && dist < nearestDist[i-1]))) {
+                if (i < K) {
+                    nearest[i] = nearest[i-1]; nearestFloor[i] = nearestFloor[i-1]; nearestDist[i] = nearestDist[i-1];
+                }
+                i--;
             }
-        }];
+            if (i < K) {
+                nearest[i] = obj; nearestFloor[i] = fd; nearestDist[i] = dist;
+                count = MIN(count+1, K);
+            }
+        }
+        for(int i = 0; i < count; i++) {
+            if (nearestFloor[i] < 0.5 && nearestDist[i] < 25) {
+                [temp addObject:[[NavDestination alloc] initWithLandmark:nearest[i]]];
+            }
+        }
         [tempSections addObject:@{@"key":NSLocalizedStringFromTable(@"_nav_near_shops",@"BlindView",@""), @"rows":temp}];
     }
     
@@ -409,10 +442,7 @@
 - (NSString*)firstLetter:(NSString*)string
 {
     NSString *first = [[string substringWithRange:NSMakeRange(0, 1)] uppercaseString];
-    NSMutableString* retStr = [[NSMutableString alloc] initWithString:first];
-    CFStringTransform((CFMutableStringRef)retStr, NULL, kCFStringTransformHiraganaKatakana, YES);
-    first = retStr;
-    return first;
+    return HLPNormalizeKana(first);
 }
 
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView
@@ -24,11 +24,16 @@
 #import "NavNavigator.h"
 #import "LocationEvent.h"
 #import "NavDataStore.h"
+#import "Logging.h"
+#import "NavCoalescer.h"
 #import "objc/runtime.h"
 
 #define FIXED @(YES)
 #define NOT_FIXED @(NO)
 
+// a navigation step longer than this (in seconds) is logged with the number of dropped updates
+#define NAVIGATION_STEP_DEADLINE 0.5
+
 /**
  * This represents all constant values for navigator.
  * The default values of the constants are defined in [+ (NSDictionary*) defaults] method.
@@ -38,15 +43,24 @@
 
 static NavNavigatorConstants *_instance;
 
+// the constants are immutable, so a shared snapshot is used until any user default is changed
+// (including a preset loaded by ConfigManager), then it is rebuilt on the next access
 + (instancetype) constants
 {
-    return [[NavNavigatorConstants alloc] init];
-    /*
-     if (!_instance) {
-     _instance = [[NavNavigatorConstants alloc] init];
-     }
-     return _instance;
-     */
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        [[NSNotificationCenter defaultCenter] addObserverForName:NSUserDefaultsDidChangeNotification object:nil queue:nil usingBlock:^(NSNotification * _Nonnull note) {
+            @synchronized(NavNavigatorConstants.class) {
+                _instance = nil;
+            }
+        }];
+    });
+    @synchronized(NavNavigatorConstants.class) {
+        if (!_instance) {
+            _instance = [[NavNavigatorConstants alloc] init];
+        }
+        return _instance;
+    }
 }
 
 - (instancetype) init
@@ -70,6 +84,16 @@ static NavNavigatorConstants *_instance;
 }
 
 + (NSArray*) allPropertyNames
+{
+    static NSArray *names;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        names = [self _allPropertyNames];
+    });
+    return names;
+}
+
++ (NSArray*) _allPropertyNames
 {
     unsigned int outCount, i;
     
@@ -150,6 +174,30 @@ static NavNavigatorConstants *_instance;
 }
 @end
 
+// sort pois by the distance from the location to their projection on the link,
+// the distances are computed once instead of in each comparison
+static NSArray<HLPPOI*>* sortPOIsAlongLink(NSArray<HLPPOI*> *pois, HLPLink *link, HLPLocation *location)
+{
+    NSUInteger count = pois.count;
+    double *dists = (double*)malloc(sizeof(double) * count);
+    NSMutableArray<NSNumber*> *indexes = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSUInteger i = 0; i < count; i++) {
+        dists[i] = [[link nearestLocationTo:pois[i].location] distanceTo:location];
+        [indexes addObject:@(i)];
+    }
+    [indexes sortUsingComparator:^NSComparisonResult(NSNumber *i1, NSNumber *i2) {
+        double d1 = dists[i1.unsignedIntegerValue], d2 = dists[i2.unsignedIntegerValue];
+        return d1 < d2 ? NSOrderedAscending : (d1 > d2 ? NSOrderedDescending : NSOrderedSame);
+    }];
+    free(dists);
+    
+    NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSNumber *i in indexes) {
+        [result addObject:pois[i.unsignedIntegerValue]];
+    }
+    return result;
+}
+
 /**
  * This represents link information and navigation state on the route.
  */
@@ -504,11 +552,7 @@ static NavNavigatorConstants *_instance;
     }]];
     
     if ([doors count] > 0) {
-        doors = [doors sortedArrayUsingComparator:^NSComparisonResult(HLPPOI *p1, HLPPOI *p2) {
-            HLPLocation *n1 = [_link nearestLocationTo:p1.location];
-            HLPLocation *n2 = [_link nearestLocationTo:p2.location];
-            return [@([n1 distanceTo:_sourceLocation]) compare:@([n2 distanceTo:_sourceLocation])];
-        }];
+        doors = sortPOIsAlongLink(doors, _link, _sourceLocation);
         
         for(int start = 0; start < [doors count];){
             HLPLocation *locStart = [_link nearestLocationTo:doors[start].location];
@@ -548,11 +592,7 @@ static NavNavigatorConstants *_instance;
     }]];
     
     if ([obstacles count] > C.MINIMUM_OBSTACLES_POI) {
-        obstacles = [obstacles sortedArrayUsingComparator:^NSComparisonResult(HLPPOI *p1, HLPPOI *p2) {
-            HLPLocation *n1 = [_link nearestLocationTo:p1.location];
-            HLPLocation *n2 = [_link nearestLocationTo:p2.location];
-            return [@([n1 distanceTo:_sourceLocation]) compare:@([n2 distanceTo:_sourceLocation])];
-        }];
+        obstacles = sortPOIsAlongLink(obstacles, _link, _sourceLocation);
         
         for(int start = 0; start < [obstacles count];){
             HLPLocation *locStart = [_link nearestLocationTo:obstacles[start].location];
@@ -896,6 +936,7 @@ static NavNavigatorConstants *_instance;
     NSTimeInterval lastElevatorResetTime;
     
     NSOperationQueue *navigationQueue;
+    NavLatestCoalescer *locationCoalescer;
     
     BOOL alertForHeadingAccuracy;
     HLPLocation *prevLocation;
@@ -923,6 +964,11 @@ static NavNavigatorConstants *_instance;
     navigationQueue = [[NSOperationQueue alloc] init];
     navigationQueue.maxConcurrentOperationCount = 1;
     navigationQueue.qualityOfService = NSQualityOfServiceUserInteractive;
+    // latest wins, so the lag is bounded by one step even if a step takes longer than the update interval
+    __weak typeof(self) weakself = self;
+    locationCoalescer = [[NavLatestCoalescer alloc] initWithQueue:navigationQueue handler:^(id note, long dropped) {
+        [weakself processLocation:note dropped:dropped];
+    }];
     
     return self;
 }
@@ -1181,10 +1227,10 @@ static NavNavigatorConstants *_instance;
             
             NSMutableSet *linkPois = [[NSMutableSet alloc] init];
             if (!isFirstLink) {
-                [linkPois addObjectsFromArray:nds.linkPoiMap[link1._id]];
+                [linkPois addObjectsFromArray:[nds poisForLink:link1]];
                 if ([link1 isKindOfClass:HLPCombinedLink.class]) {
                     for(HLPLink *link in [(HLPCombinedLink*) link1 links]) {
-                        [linkPois addObjectsFromArray:nds.linkPoiMap[link._id]];
+                        [linkPois addObjectsFromArray:[nds poisForLink:link]];
                     }
                 }
             }
@@ -1245,9 +1291,25 @@ static NavNavigatorConstants *_instance;
     BOOL isManualLocation = [NavDataStore sharedDataStore].isManualLocation;
     BOOL devMode = [[NSUserDefaults standardUserDefaults] boolForKey:@"developer_mode"];
     if (!isManualLocation || devMode) {
-        [navigationQueue addOperationWithBlock:^{
-            [self locationChanged:note];
-        }];
+        [locationCoalescer submit:note];
+    }
+}
+
+- (void)processLocation:(NSNotification*)note dropped:(long)dropped
+{
+    long span = [note.userInfo[@"trace"] longValue];
+    NSTimeInterval start = [[NSProcessInfo processInfo] systemUptime];
+    
+    // speech requested while handling this update is traced with the same span
+    [Logging trace:span stage:@"navigator_start"];
+    [Logging setTraceActiveSpan:span];
+    [self locationChanged:note];
+    [Logging setTraceActiveSpan:0];
+    [Logging trace:span stage:@"navigator_end"];
+    
+    NSTimeInterval elapsed = [[NSProcessInfo processInfo] systemUptime] - start;
+    if (elapsed > NAVIGATION_STEP_DEADLINE || dropped > 0) {
+        NSLog(@"NavigationStep,%.3f,%ld,%f", elapsed, dropped, NSDate.date.timeIntervalSince1970);
     }
 }
 
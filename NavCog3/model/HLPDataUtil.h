@@ -42,6 +42,7 @@
 
 +(void)postRequest:(NSURL*) url withData:(NSDictionary*) data callback:(void(^)(NSData* response))callback;
 +(void)postRequest:(NSURL*) url contentType:(NSString*)type withData:(NSData*) data callback:(void(^)(NSData* response))callback;
++(void)postRequest:(NSURL*) url contentType:(NSString*)type withFile:(NSString*) path callback:(void(^)(NSData* response))callback;
 +(void)deleteRequest:(NSURL*) url withData:(NSDictionary*) data callback:(void(^)(NSData* response))callback;
 
 @end
@@ -318,6 +318,45 @@
     [HLPDataUtil method:@"POST" request:url contentType:type withData:data callback:callback];
 }
 
+// the body is streamed from the file, so a large body does not need to be in memory
++(void)postRequest:(NSURL*) url contentType:(NSString*)type withFile:(NSString*) path callback:(void(^)(NSData* response))callback
+{
+    @try{
+        NSMutableURLRequest *request = [NSMutableURLRequest
+                                        requestWithURL: url
+                                        cachePolicy: NSURLRequestReloadIgnoringLocalAndRemoteCacheData
+                                        timeoutInterval: 60.0];
+        
+        NSLog(@"Requesting %@", url);
+        
+        unsigned long long length = [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil] fileSize];
+        [request setHTTPMethod: @"POST"];
+        [request setValue:type forHTTPHeaderField: @"Content-Type"];
+        [request setValue:[NSString stringWithFormat: @"%llu", length]  forHTTPHeaderField: @"Content-Length"];
+        
+        NSURLSession *session = [NSURLSession sharedSession];
+        
+        [[session uploadTaskWithRequest:request fromFile:[NSURL fileURLWithPath:path] completionHandler: ^(NSData *data, NSURLResponse *response, NSError *error) {
+            @try {
+                if (response && ! error) {
+                    callback(data);
+                }
+                else {
+                    NSLog(@"Error: %@", [error localizedDescription]);
+                    callback(nil);
+                }
+            }
+            @catch(NSException *e) {
+                NSLog(@"%@", [e debugDescription]);
+            }
+        }] resume];
+    }
+    @catch(NSException *e) {
+        NSLog(@"%@", [e debugDescription]);
+        callback(nil);
+    }
+}
+
 +(void)deleteRequest:(NSURL*) url withData:(NSDictionary*) data callback:(void(^)(NSData* response))callback
 {
     [HLPDataUtil method:@"DELETE" request:url withData:data callback:callback];
@@ -25,6 +25,9 @@
 #import <Mantle.h>
 #import "HLPGeoJSON.h"
 
+// hiragana to katakana, used to compare and index pronunciations
+NSString* HLPNormalizeKana(NSString *str);
+
 @class HLPDirectory;
 
 @interface HLPDirectoryItem : MTLModel<MTLJSONSerializing, NSCoding>
@@ -58,5 +61,6 @@
 
 - (void) walk:(BOOL(^)(HLPDirectoryItem*))func withBuffer:(NSMutableArray*)buffer;
 - (void) addSection:(HLPDirectorySection*)section atIndex:(NSUInteger)index;
+- (HLPDirectory*) search:(NSString*)query;
 @end
 
@@ -119,7 +119,155 @@
 
 @end
 
-@implementation HLPDirectory
+NSString* HLPNormalizeKana(NSString *str)
+{
+    NSMutableString* retStr = [[NSMutableString alloc] initWithString:str];
+    CFStringTransform((CFMutableStringRef)retStr, NULL, kCFStringTransformHiraganaKatakana, YES);
+    return retStr;
+}
+
+// normalize for search: kana as in HLPNormalizeKana, width and case are folded and spaces are removed
+static NSString* normalizeForSearch(NSString *str)
+{
+    if (!str) {
+        return @"";
+    }
+    NSMutableString* retStr = [HLPNormalizeKana(str) mutableCopy];
+    CFStringFold((CFMutableStringRef)retStr, kCFCompareCaseInsensitive | kCFCompareWidthInsensitive, NULL);
+    [retStr replaceOccurrencesOfString:@"\\s+" withString:@"" options:NSRegularExpressionSearch range:NSMakeRange(0, retStr.length)];
+    return retStr;
+}
+
+#pragma mark - search index
+
+@interface HLPDirectorySearchEntry : NSObject {
+    @public
+    HLPDirectoryItem *item;
+    NSString *title;
+    NSString *pron;
+    NSString *subtitle;
+}
+@end
+
+@implementation HLPDirectorySearchEntry
+@end
+
+// flattened leaf items with normalized strings and a bigram index to narrow candidates
+@interface HLPDirectorySearchIndex : NSObject
+- (instancetype) initWithDirectory:(HLPDirectory*)directory;
+- (NSArray<HLPDirectoryItem*>*) search:(NSString*)query;
+@end
+
+@implementation HLPDirectorySearchIndex {
+    NSArray<HLPDirectorySearchEntry*> *entries;
+    NSDictionary<NSString*, NSIndexSet*> *bigrams;
+    
+    NSString *lastQuery;
+    NSIndexSet *lastCandidates;
+}
+
+- (instancetype) initWithDirectory:(HLPDirectory*)directory
+{
+    self = [super init];
+    
+    NSMutableArray *items = [@[] mutableCopy];
+    [directory walk:^BOOL(HLPDirectoryItem *item) {
+        return YES;
+    } withBuffer:items];
+    
+    NSMutableArray *temp = [@[] mutableCopy];
+    NSMutableDictionary<NSString*, NSMutableIndexSet*> *grams = [@{} mutableCopy];
+    for(HLPDirectoryItem *item in items) {
+        HLPDirectorySearchEntry *entry = [[HLPDirectorySearchEntry alloc] init];
+        entry->item = item;
+        entry->title = normalizeForSearch([item getItemTitle]);
+        entry->pron = normalizeForSearch([item getItemTitlePron]);
+        entry->subtitle = normalizeForSearch([item getItemSubtitle]);
+        
+        NSUInteger index = temp.count;
+        for(NSString *str in @[entry->title, entry->pron, entry->subtitle]) {
+            for(NSUInteger i = 0; i + 2 <= str.length; i++) {
+                NSString *gram = [str substringWithRange:NSMakeRange(i, 2)];
+                NSMutableIndexSet *set = grams[gram];
+                if (!set) {
+                    set = grams[gram] = [[NSMutableIndexSet alloc] init];
+                }
+                [set addIndex:index];
+            }
+        }
+        [temp addObject:entry];
+    }
+    entries = temp;
+    bigrams = grams;
+    return self;
+}
+
+- (NSIndexSet*) candidatesFor:(NSString*)query
+{
+    // narrow down from the previous result while the user keeps typing
+    if (lastQuery && [query hasPrefix:lastQuery]) {
+        return lastCandidates;
+    }
+    if (query.length < 2) {
+        return [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, entries.count)];
+    }
+    NSMutableIndexSet *result = nil;
+    for(NSUInteger i = 0; i + 2 <= query.length; i++) {
+        NSIndexSet *set = bigrams[[query substringWithRange:NSMakeRange(i, 2)]];
+        if (!set) {
+            return [NSIndexSet indexSet];
+        }
+        if (!result) {
+            result = [set mutableCopy];
+        } else {
+            [result removeIndexes:[result indexesPassingTest:^BOOL(NSUInteger idx, BOOL *stop) {
+                return ![set containsIndex:idx];
+            }]];
+        }
+    }
+    return result;
+}
+
+- (NSArray<HLPDirectoryItem*>*) search:(NSString*)query
+{
+    query = normalizeForSearch(query);
+    if (query.length == 0) {
+        return @[];
+    }
+    NSIndexSet *candidates = [self candidatesFor:query];
+    
+    // rank: title/pron prefix, title/pron substring, subtitle substring
+    NSMutableArray *ranks[3] = {[@[] mutableCopy], [@[] mutableCopy], [@[] mutableCopy]};
+    NSMutableIndexSet *matched = [[NSMutableIndexSet alloc] init];
+    [candidates enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        HLPDirectorySearchEntry *entry = entries[idx];
+        int rank;
+        if ([entry->title hasPrefix:query] || [entry->pron hasPrefix:query]) {
+            rank = 0;
+        } else if ([entry->title containsString:query] || [entry->pron containsString:query]) {
+            rank = 1;
+        } else if ([entry->subtitle containsString:query]) {
+            rank = 2;
+        } else {
+            return;
+        }
+        [ranks[rank] addObject:entry->item];
+        [matched addIndex:idx];
+    }];
+    lastQuery = query;
+    lastCandidates = matched;
+    
+    NSMutableArray *result = ranks[0];
+    [result addObjectsFromArray:ranks[1]];
+    [result addObjectsFromArray:ranks[2]];
+    return result;
+}
+
+@end
+
+@implementation HLPDirectory {
+    HLPDirectorySearchIndex *searchIndex;
+}
 
 -(id) copyWithZone:(NSZone *) zone
 {
@@ -153,6 +301,29 @@
     NSMutableArray *temp = [_sections mutableCopy];
     [temp insertObject:section atIndex:index];
     _sections = temp;
+    searchIndex = nil;
+}
+
+- (void)setSections:(NSArray<HLPDirectorySection *> *)sections
+{
+    _sections = sections;
+    searchIndex = nil;
+}
+
+- (HLPDirectory *)search:(NSString *)query
+{
+    @synchronized(self) {
+        if (!searchIndex) {
+            searchIndex = [[HLPDirectorySearchIndex alloc] initWithDirectory:self];
+        }
+        NSArray *items = [searchIndex search:query];
+        
+        HLPDirectorySection *section = [[HLPDirectorySection alloc] init];
+        section.items = items;
+        HLPDirectory *directory = [[HLPDirectory alloc] init];
+        directory.sections = items.count > 0 ? @[section] : @[];
+        return directory;
+    }
 }
 
 @end
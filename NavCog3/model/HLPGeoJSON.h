@@ -76,6 +76,8 @@
 - (instancetype)initWithLocations:(NSArray*) locations;
 - (HLPLocation*)point;
 - (NSArray<HLPLocation*>*)points;
+// coordinates as packed (lng, lat) double pairs, one pair for a Point
+- (NSData*)packedCoordinates;
 @end
 
 
@@ -24,7 +24,49 @@
 #import <HLPLocationManager/HLPLocation.h>
 #import "objc/runtime.h"
 
-@implementation HLPGeometry
+#pragma mark - local planar projection
+
+// Equirectangular projection on a tangent plane at an origin (meters, x east, y north).
+// Within 1km of the origin the relative distance error is below 2e-4 (mid latitudes),
+// which is far below the map accuracy, and much cheaper than spherical math.
+#define EARTH_RADIUS 6378137.0
+
+typedef struct {
+    double lat0, lng0;
+    double mx, my; // meters per degree
+} HLPLocalProjection;
+
+static inline HLPLocalProjection localProjectionAt(double lat, double lng)
+{
+    HLPLocalProjection p;
+    p.lat0 = lat;
+    p.lng0 = lng;
+    p.my = EARTH_RADIUS * M_PI / 180.0;
+    p.mx = p.my * cos(lat * M_PI / 180.0);
+    return p;
+}
+
+static inline void localProject(HLPLocalProjection *p, double lat, double lng, double *x, double *y)
+{
+    *x = (lng - p->lng0) * p->mx;
+    *y = (lat - p->lat0) * p->my;
+}
+
+// nearest point to (px,py) on the segment (ax,ay)-(bx,by)
+static inline void localNearestOnSegment(double px, double py, double ax, double ay, double bx, double by, double *nx, double *ny)
+{
+    double dx = bx - ax, dy = by - ay;
+    double len2 = dx*dx + dy*dy;
+    double t = len2 < 1e-10 ? 0 : ((px - ax)*dx + (py - ay)*dy) / len2;
+    t = MAX(0, MIN(1, t));
+    *nx = ax + t*dx;
+    *ny = ay + t*dy;
+}
+
+@implementation HLPGeometry {
+    NSData *packed;
+}
+
 + (NSDictionary *)JSONKeyPathsByPropertyKey
 {
     return @{
@@ -35,7 +77,32 @@
 
 -(void)updateCoordinates:(NSArray *)coordinates
 {
-    _coordinates = coordinates;
+    @synchronized(self) {
+        _coordinates = coordinates;
+        packed = nil;
+    }
+}
+
+- (NSData *)packedCoordinates
+{
+    @synchronized(self) {
+        if (!packed) {
+            NSArray *coords = (!_coordinates || [_coordinates.firstObject isKindOfClass:NSArray.class]) ? _coordinates : @[_coordinates];
+            NSUInteger count = 0;
+            double *buffer = (double*)malloc(sizeof(double) * 2 * MAX(coords.count, 1));
+            for(NSArray *a in coords) {
+                if (![a isKindOfClass:NSArray.class] || a.count < 2 || ![a[0] isKindOfClass:NSNumber.class]) {
+                    count = 0; // not a Point nor a LineString
+                    break;
+                }
+                buffer[count*2] = [a[0] doubleValue];
+                buffer[count*2+1] = [a[1] doubleValue];
+                count++;
+            }
+            packed = [NSData dataWithBytesNoCopy:buffer length:sizeof(double) * 2 * count freeWhenDone:YES];
+        }
+        return packed;
+    }
 }
 
 - (instancetype)initWithLocations:(NSArray *)locations
@@ -83,11 +150,7 @@
 
 @end
 
-@implementation HLPGeoJSONFeature {
-    HLPLocation *loc1;
-    HLPLocation *loc2;
-    HLPLocation *loc3;
-}
+@implementation HLPGeoJSONFeature
 
 +(NSDictionary *)JSONKeyPathsByPropertyKey
 {
@@ -101,40 +164,36 @@
 
 - (HLPLocation*)nearestLocationTo:(HLPLocation*)location
 {
-    if (!loc1) {
-        loc1 = [[HLPLocation alloc] init];
-        loc2 = [[HLPLocation alloc] init];
-        loc3 = [[HLPLocation alloc] init];
-    }
-    
-    [loc1 update:location];
     double dist = DBL_MAX;
     HLPLocation *minloc;
     if ([self.geometry.type isEqualToString:@"Point"]) {
-        [loc2 updateLat:[self.geometry.coordinates[1] doubleValue]
-                    Lng:[self.geometry.coordinates[0] doubleValue]];
-        minloc = [[HLPLocation alloc] init];
-        [minloc update:loc2];
-        dist = [loc1 distanceTo:loc2];
+        minloc = [[HLPLocation alloc] initWithLat:[self.geometry.coordinates[1] doubleValue]
+                                              Lng:[self.geometry.coordinates[0] doubleValue]];
     } else if ([self.geometry.type isEqualToString:@"LineString"]) {
-        for(int i = 0; i < [self.geometry.coordinates count]-1; i++) {
-            [loc2 updateLat:[self.geometry.coordinates[i][1] doubleValue]
-                        Lng:[self.geometry.coordinates[i][0] doubleValue]];
-            [loc3 updateLat:[self.geometry.coordinates[i+1][1] doubleValue]
-                        Lng:[self.geometry.coordinates[i+1][0] doubleValue]];
+        // planar search around the location, only the result is converted back
+        HLPLocalProjection proj = localProjectionAt(location.lat, location.lng);
+        NSData *packed = [self.geometry packedCoordinates];
+        const double *c = (const double*)packed.bytes;
+        NSUInteger count = packed.length / sizeof(double) / 2;
+        double ax, ay, bx = 0, by = 0, mx = 0, my = 0;
+        if (count > 0) {
+            localProject(&proj, c[1], c[0], &bx, &by);
+        }
+        for(NSUInteger i = 1; i < count; i++) {
+            ax = bx; ay = by;
+            localProject(&proj, c[i*2+1], c[i*2], &bx, &by);
             
-            HLPLocation *loc = [loc1 nearestLocationToLineFromLocation:loc2 ToLocation:loc3];
-            double temp = [loc1 distanceToLineFromLocation:loc2 ToLocation:loc3];
-            if ([loc2 distanceTo:loc3] < 1e-5) {
-                loc = [[HLPLocation alloc] init];
-                [loc update:loc2];
-                temp = [loc2 distanceTo:loc1];
-            }
+            double nx, ny;
+            localNearestOnSegment(0, 0, ax, ay, bx, by, &nx, &ny);
+            double temp = nx*nx + ny*ny;
             if (temp < dist) {
                 dist = temp;
-                minloc = loc;
+                mx = nx; my = ny;
             }
         }
+        if (dist < DBL_MAX) {
+            minloc = [[HLPLocation alloc] initWithLat:proj.lat0 + my / proj.my Lng:proj.lng0 + mx / proj.mx];
+        }
     }
     [minloc updateFloor:location.floor];
     return minloc;
@@ -803,19 +862,29 @@ static NSRegularExpression *patternHLPPOIFlags;
 
 - (double)bearingAtLocation:(HLPLocation *)loc
 {
-    int i = 0;
     double orientation = 0;
     double min = DBL_MAX;
-    NSArray *points = _geometry.points;
-    for(;i<[points count]-1; i++) {
-        HLPLocation *a = points[i];
-        HLPLocation *b = points[i+1];
+    if (![_geometry.type isEqualToString:@"LineString"]) {
+        return orientation;
+    }
+    HLPLocalProjection proj = localProjectionAt(loc.lat, loc.lng);
+    NSData *packed = [_geometry packedCoordinates];
+    const double *c = (const double*)packed.bytes;
+    NSUInteger count = packed.length / sizeof(double) / 2;
+    double ax, ay, bx = 0, by = 0;
+    if (count > 0) {
+        localProject(&proj, c[1], c[0], &bx, &by);
+    }
+    for(NSUInteger i = 1; i < count; i++) {
+        ax = bx; ay = by;
+        localProject(&proj, c[i*2+1], c[i*2], &bx, &by);
         
-        HLPLocation *c = [loc nearestLocationToLineFromLocation:a ToLocation:b];
-        double d = [c distanceTo:loc];
+        double cx, cy;
+        localNearestOnSegment(0, 0, ax, ay, bx, by, &cx, &cy);
+        double d = cx*cx + cy*cy;
         if (d < min) {
             min = d;
-            orientation = [c bearingTo:b];
+            orientation = atan2(bx - cx, by - cy) * 180 / M_PI;
         }
     }
     return orientation;
@@ -842,19 +911,24 @@ static NSRegularExpression *patternHLPPOIFlags;
         return [[HLPLocation alloc] initWithLat:[_geometry.coordinates[1] doubleValue] Lng:[_geometry.coordinates[0] doubleValue]];
     }
     
-    NSArray *coords = _geometry.coordinates;
-    if (!_backward) {
-        coords = [[coords reverseObjectEnumerator] allObjects];
+    // walk from the target, which is the last point unless the link is backward
+    NSData *packed = [_geometry packedCoordinates];
+    const double *c = (const double*)packed.bytes;
+    NSInteger count = packed.length / sizeof(double) / 2;
+    if (count == 0) {
+        return nil;
     }
+    NSInteger start = _backward ? 0 : count-1;
+    NSInteger step = _backward ? 1 : -1;
     
     HLPLocation *loc = nil;
-    for(int i = 0; i < [coords count]-1; i++) {
-        NSArray *p1 = coords[i];
-        NSArray *p2 = coords[i+1];
-        double lat1 = [p1[1] doubleValue];
-        double lng1 = [p1[0] doubleValue];
-        double lat2 = [p2[1] doubleValue];
-        double lng2 = [p2[0] doubleValue];
+    for(NSInteger i = 0; i < count-1; i++) {
+        const double *p1 = c + (start + step*i)*2;
+        const double *p2 = c + (start + step*(i+1))*2;
+        double lat1 = p1[1];
+        double lng1 = p1[0];
+        double lat2 = p2[1];
+        double lng2 = p2[0];
         
         double d = [HLPLocation distanceFromLat:lat1 Lng:lng1 toLat:lat2 Lng:lng2];
         
@@ -867,7 +941,8 @@ static NSRegularExpression *patternHLPPOIFlags;
         distance -= d;
     }
     if (loc == nil) {
-        loc =  [[HLPLocation alloc] initWithLat:[[coords lastObject][1] doubleValue] Lng:[[coords lastObject][0] doubleValue]];
+        const double *last = c + (start + step*(count-1))*2;
+        loc =  [[HLPLocation alloc] initWithLat:last[1] Lng:last[0]];
     }
 
     return loc;
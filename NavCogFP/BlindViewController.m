@@ -554,7 +554,8 @@
     NavDataStore *nds = [NavDataStore sharedDataStore];
     if (nds.isManualLocation) {
         if (fpm.selectedRefpoint) {
-            MKMapPoint local = [FingerprintManager convertFromGlobal: CLLocationCoordinate2DMake([nds currentLocation].lat, [nds currentLocation].lng) ToLocalWithRefpoint:fpm.selectedRefpoint];
+            HLPLocation *loc = [nds currentLocation];
+            MKMapPoint local = [FingerprintManager convertFromGlobal: CLLocationCoordinate2DMake(loc.lat, loc.lng) ToLocalWithRefpoint:fpm.selectedRefpoint];
             fx = local.x;
             fy = local.y;
         }
@@ -953,6 +954,10 @@
 
 - (void) showFingerprints:(NSArray*) points
 {
+    if ([[NSUserDefaults standardUserDefaults] boolForKey:@"finger_printing_show_coverage"]) {
+        [self showCoverage:fpm.coverage.cells];
+        return;
+    }
     [self showFeatures:points withStyle:^NSDictionary *(NSObject *obj) {
         if([obj isKindOfClass:HLPSampling.class]) {
             HLPSampling *p = (HLPSampling*)obj;
@@ -966,6 +971,23 @@
     }];
 }
 
+// samplings / visible beacons per cell, "!" marks weak coverage
+- (void) showCoverage:(NSArray<HLPFingerprintCoverageCell*>*) cells
+{
+    [self showFeatures:cells withStyle:^NSDictionary *(NSObject *obj) {
+        if([obj isKindOfClass:HLPFingerprintCoverageCell.class]) {
+            HLPFingerprintCoverageCell *c = (HLPFingerprintCoverageCell*)obj;
+            BOOL weak = c.beaconCount < 3 || c.rssiMean < -90;
+            return @{
+                     @"lat": @(c.lat),
+                     @"lng": @(c.lng),
+                     @"count": [NSString stringWithFormat:@"%ld/%ld%@", c.sampleCount, c.beaconCount, weak?@"!":@""]
+                     };
+        }
+        return (NSDictionary*)nil;
+    }];
+}
+
 - (void) showARFingerprints:(NSArray*) samples
 {
     [self showFeatures:samples withStyle:^NSDictionary *(NSObject *obj) {
@@ -41,6 +41,27 @@
 -(void)manager:(FingerprintManager*)manager didARLocationChange:(HLPLocation*)location;
 @end
 
+// aggregated samplings in a grid cell of the selected refpoint
+@interface HLPFingerprintCoverageCell : NSObject
+@property (readonly) double lat;
+@property (readonly) double lng;
+@property (readonly) long sampleCount;
+@property (readonly) long beaconCount;
+@property (readonly) double rssiMean;
+@property (readonly) double rssiVariance;
+@end
+
+@interface HLPFingerprintCoverage : NSObject
+@property (readonly) HLPRefpoint *refpoint;
+@property (readonly) double cellSize;
+@property (readonly) NSArray<HLPFingerprintCoverageCell*> *cells;
+
+- (instancetype) initWithRefpoint:(HLPRefpoint*)refpoint cellSize:(double)cellSize;
+- (void) addSampling:(HLPSampling*)sampling;
+- (void) removeSamplingWithId:(NSString*)oid;
+- (void) updateWithSamplings:(NSArray<HLPSampling*>*)samplings;
+@end
+
 @interface FingerprintManager : NSObject <HLPBeaconSamplerDelegate>
 
 @property id<FingerprintManagerDelegate> delegate;
@@ -53,6 +74,7 @@
 @property NSMutableDictionary<NSString*, HLPRefpoint*> *floorplanRefpointMap;
 @property NSMutableDictionary<NSString*, HLPFloorplan*> *floorplanMap;
 @property NSArray *samplings;
+@property (readonly) HLPFingerprintCoverage *coverage;
 @property (readonly) HLPRefpoint *selectedRefpoint;
 @property (readonly) HLPFloorplan *selectedFloorplan;
 @property (readonly) HLPBeaconSampler *sampler;
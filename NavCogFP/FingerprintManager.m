@@ -32,6 +32,211 @@
 #define FLOORPLANS_API_URL @"%@://%@/data/floorplans%@"
 #define REFPOINTS_API_URL @"%@://%@/data/refpoints%@"
 
+#define COVERAGE_CELL_SIZE 3.0
+
+@interface HLPFingerprintCoverageCell ()
+- (instancetype) initWithX:(long)x Y:(long)y atCoordinate:(CLLocationCoordinate2D)coordinate;
+- (void) addSampling:(HLPSampling*)sampling;
+- (void) removeSampling:(HLPSampling*)sampling;
+@end
+
+@implementation HLPFingerprintCoverageCell {
+    long ix, iy;
+    NSCountedSet<NSNumber*> *beacons;
+    long rssiCount;
+    double rssiM2;
+}
+
+- (instancetype)initWithX:(long)x Y:(long)y atCoordinate:(CLLocationCoordinate2D)coordinate
+{
+    self = [super init];
+    ix = x;
+    iy = y;
+    _lat = coordinate.latitude;
+    _lng = coordinate.longitude;
+    beacons = [[NSCountedSet alloc] init];
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"coverage cell %ld,%ld", ix, iy];
+}
+
+- (long)beaconCount
+{
+    return beacons.count;
+}
+
+- (double)rssiVariance
+{
+    return rssiCount > 1 ? rssiM2 / (rssiCount - 1) : 0;
+}
+
+- (void)enumerateRSSIOf:(HLPSampling*)sampling withBlock:(void(^)(NSNumber *beacon, double rssi))block
+{
+    for(NSDictionary *b in sampling.beacons) {
+        if (![b isKindOfClass:NSDictionary.class] || ![b[@"data"] isKindOfClass:NSArray.class]) {
+            continue;
+        }
+        for(NSDictionary *d in b[@"data"]) {
+            if (![d isKindOfClass:NSDictionary.class]) {
+                continue;
+            }
+            double rssi = [d[@"rssi"] doubleValue];
+            if (rssi >= 0) { // unknown
+                continue;
+            }
+            block(@(([d[@"major"] unsignedIntValue] << 16) | [d[@"minor"] unsignedIntValue]), rssi);
+        }
+    }
+}
+
+- (void)addSampling:(HLPSampling*)sampling
+{
+    _sampleCount++;
+    [self enumerateRSSIOf:sampling withBlock:^(NSNumber *beacon, double rssi) {
+        [beacons addObject:beacon];
+        // Welford's online mean and variance
+        rssiCount++;
+        double delta = rssi - _rssiMean;
+        _rssiMean += delta / rssiCount;
+        rssiM2 += delta * (rssi - _rssiMean);
+    }];
+}
+
+- (void)removeSampling:(HLPSampling*)sampling
+{
+    _sampleCount--;
+    [self enumerateRSSIOf:sampling withBlock:^(NSNumber *beacon, double rssi) {
+        [beacons removeObject:beacon];
+        // reverse of the Welford update in addSampling:
+        if (rssiCount <= 1) {
+            rssiCount = 0;
+            _rssiMean = rssiM2 = 0;
+            return;
+        }
+        double mean = (_rssiMean * rssiCount - rssi) / (rssiCount - 1);
+        rssiM2 = MAX(0, rssiM2 - (rssi - mean) * (rssi - _rssiMean));
+        _rssiMean = mean;
+        rssiCount--;
+    }];
+}
+
+@end
+
+@implementation HLPFingerprintCoverage {
+    NSMutableDictionary<NSNumber*, HLPFingerprintCoverageCell*> *cellMap;
+    NSMutableDictionary<NSString*, HLPSampling*> *added;
+    NSMutableArray<HLPSampling*> *unkeyed;
+}
+
+- (instancetype)initWithRefpoint:(HLPRefpoint *)refpoint cellSize:(double)cellSize
+{
+    self = [super init];
+    _refpoint = refpoint;
+    _cellSize = cellSize;
+    cellMap = [@{} mutableCopy];
+    added = [@{} mutableCopy];
+    unkeyed = [@[] mutableCopy];
+    return self;
+}
+
+static NSString* samplingOid(HLPSampling *sampling)
+{
+    return [sampling._id isKindOfClass:NSDictionary.class] ? sampling._id[@"$oid"] : nil;
+}
+
+- (NSArray<HLPFingerprintCoverageCell *> *)cells
+{
+    @synchronized(self) {
+        return cellMap.allValues;
+    }
+}
+
+- (NSNumber*)keyForSampling:(HLPSampling*)sampling X:(long*)ix Y:(long*)iy
+{
+    *ix = (long)floor(sampling.information.absx / _cellSize);
+    *iy = (long)floor(sampling.information.absy / _cellSize);
+    return @(((uint64_t)*ix << 32) | (uint32_t)*iy);
+}
+
+- (void)addSampling:(HLPSampling *)sampling
+{
+    @synchronized(self) {
+        // a sampling listed twice is aggregated once, ones without an id cannot be
+        // matched to others and are replaced as a whole in updateWithSamplings:
+        NSString *oid = samplingOid(sampling);
+        if (oid) {
+            if (added[oid]) {
+                return;
+            }
+            added[oid] = sampling;
+        } else {
+            [unkeyed addObject:sampling];
+        }
+        
+        long ix, iy;
+        NSNumber *key = [self keyForSampling:sampling X:&ix Y:&iy];
+        HLPFingerprintCoverageCell *cell = cellMap[key];
+        if (!cell) {
+            MKMapPoint local = MKMapPointMake((ix + 0.5) * _cellSize, (iy + 0.5) * _cellSize);
+            CLLocationCoordinate2D global = [FingerprintManager convertFromLocal:local ToGlobalWithRefpoint:_refpoint];
+            cell = cellMap[key] = [[HLPFingerprintCoverageCell alloc] initWithX:ix Y:iy atCoordinate:global];
+        }
+        [cell addSampling:sampling];
+    }
+}
+
+- (void)subtractSampling:(HLPSampling *)sampling
+{
+    long ix, iy;
+    NSNumber *key = [self keyForSampling:sampling X:&ix Y:&iy];
+    HLPFingerprintCoverageCell *cell = cellMap[key];
+    [cell removeSampling:sampling];
+    if (cell.sampleCount <= 0) {
+        [cellMap removeObjectForKey:key];
+    }
+}
+
+- (void)removeSamplingWithId:(NSString *)oid
+{
+    @synchronized(self) {
+        HLPSampling *sampling = oid ? added[oid] : nil;
+        if (sampling) {
+            [added removeObjectForKey:oid];
+            [self subtractSampling:sampling];
+        }
+    }
+}
+
+- (void)updateWithSamplings:(NSArray<HLPSampling *> *)samplings
+{
+    @synchronized(self) {
+        // only the difference to the aggregated samplings is applied
+        for(HLPSampling *sp in unkeyed) {
+            [self subtractSampling:sp];
+        }
+        [unkeyed removeAllObjects];
+        
+        NSMutableSet<NSString*> *oids = [[NSMutableSet alloc] init];
+        for(HLPSampling *sp in samplings) {
+            NSString *oid = samplingOid(sp);
+            if (oid) {
+                [oids addObject:oid];
+            }
+            [self addSampling:sp];
+        }
+        for(NSString *oid in added.allKeys) {
+            if (![oids containsObject:oid]) {
+                [self removeSamplingWithId:oid];
+            }
+        }
+    }
+}
+
+@end
+
 @implementation FingerprintManager {
     double lat,lng,x,y,dx,dy;
     SCNVector3 currentArPosition;
@@ -234,6 +439,12 @@ static FingerprintManager *instance;
                 }
             }
             _samplings = temp;
+            
+            if (!_coverage || _coverage.refpoint != _selectedRefpoint) {
+                _coverage = [[HLPFingerprintCoverage alloc] initWithRefpoint:_selectedRefpoint cellSize:COVERAGE_CELL_SIZE];
+            }
+            // catches changes made elsewhere, the ones from this device are already applied
+            [_coverage updateWithSamplings:temp];
             complete();
         }
     }];
@@ -494,13 +705,13 @@ static FingerprintManager *instance;
              @"floor_num": @(refpoint.floor_num)
              };
     
-    NSArray *array = [_sampler toJSON:info];
+    NSData *json = [_sampler JSONData:info];
 
     NSDictionary *meta = @{@"name": refpoint.floor};
     
     NSDictionary *data = @{
                            @"_metadata": [self stringify:meta],
-                           @"data":      [self stringify:array]
+                           @"data":      [[NSString alloc] initWithData:json encoding:NSUTF8StringEncoding]
                            };
     NSString *https = [[NSUserDefaults standardUserDefaults] boolForKey:@"https_connection"]?@"https":@"http";
     NSString *server = [[ServerConfig sharedConfig] fingerPrintingServerHost];
@@ -518,6 +729,12 @@ static FingerprintManager *instance;
                 //NSLog(@"sent %ld", [response length]);
                 [_delegate manager:self didSendData:nil withError:nil];
                 
+                // the new record is added to the coverage here, the reload below only finds it already counted
+                HLPSampling *sp = [dic isKindOfClass:NSDictionary.class] ? [MTLJSONAdapter modelOfClass:HLPSampling.class fromJSONDictionary:dic error:nil] : nil;
+                if (sp.information && refpoint == _coverage.refpoint) {
+                    [_coverage addSampling:sp];
+                }
+                
                 [self loadSamplings:^{
                     [_delegate manager:self didSamplingsLoaded:_samplings];
                 }];
@@ -537,6 +754,9 @@ static FingerprintManager *instance;
     NSURL *url = [NSURL URLWithString:[NSString stringWithFormat:SAMPLINGS_API_URL, https, server, [@"/" stringByAppendingString:idString]]];
     
     [HLPDataUtil deleteRequest:url withData:nil callback:^(NSData *response) {
+        if (response) {
+            [_coverage removeSamplingWithId:idString];
+        }
         [self loadSamplings:^{
             [_delegate manager:self didSamplingsLoaded:_samplings];
         }];
@@ -55,6 +55,6 @@ typedef NS_ENUM(NSInteger, HLPBeaconSamplesType) {
 - (void) transform2D:(CGAffineTransform)param;
 - (NSInteger) count;
 - (NSArray*) toJSON:(NSDictionary*)optionalInfo;
-
+- (NSData*) JSONData:(NSDictionary*)optionalInfo;
 
 @end
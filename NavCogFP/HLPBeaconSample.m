@@ -115,18 +115,43 @@
 @end
     
     
-@implementation HLPBeaconSamples
+#define SAMPLES_CHUNK_SIZE 1024
 
+@implementation HLPBeaconSamples {
+    // fixed size chunks so appending never copies the samples already recorded
+    NSMutableArray<NSMutableArray<HLPBeaconSample*>*> *chunks;
+    NSInteger count;
+    NSArray<HLPBeaconSample*> *snapshot;
+}
 
 - (instancetype)initWithType:(HLPBeaconSamplesType)type {
     self = [super init];
     _type = type;
+    chunks = [@[] mutableCopy];
+    count = 0;
     return self;
 }
 
+- (NSArray<HLPBeaconSample *> *)samples
+{
+    @synchronized(self) {
+        if (count == 0) {
+            return nil;
+        }
+        if (snapshot.count != count) {
+            NSMutableArray *temp = [[NSMutableArray alloc] initWithCapacity:count];
+            for(NSArray *chunk in chunks) {
+                [temp addObjectsFromArray:chunk];
+            }
+            snapshot = temp;
+        }
+        return snapshot;
+    }
+}
+
 - (void)transform2D:(CGAffineTransform)param
 {
-    for(HLPBeaconSample* sample in _samples) {
+    for(HLPBeaconSample* sample in self.samples) {
         [sample transform2D:param];
     }
 }
@@ -135,22 +160,27 @@
 - (void)addBeacons:(NSArray<CLBeacon *> *)beacons atPoint:(HLPPoint3D *)point
 {
     HLPBeaconSample *sample = [[HLPBeaconSample alloc] initWithBeacons:beacons atPoint:point];
-    if (_samples == nil) {
-        _samples = @[sample];
-    } else {
-        _samples = [_samples arrayByAddingObject:sample];
+    @synchronized(self) {
+        NSMutableArray *chunk = chunks.lastObject;
+        if (chunk == nil || chunk.count == SAMPLES_CHUNK_SIZE) {
+            chunk = [[NSMutableArray alloc] initWithCapacity:SAMPLES_CHUNK_SIZE];
+            [chunks addObject:chunk];
+        }
+        [chunk addObject:sample];
+        count++;
     }
 }
 
 - (NSArray *)toJSON:(NSDictionary *)optionalInfo {
     NSMutableArray *json = [@[] mutableCopy];
+    NSArray<HLPBeaconSample*> *samples = self.samples;
     
     if (_type == HLPBeaconSamplesBeacon) {
         NSMutableDictionary *obj = [@{} mutableCopy];
         NSMutableDictionary *info = [optionalInfo?optionalInfo:@{} mutableCopy];
-        NSMutableArray<NSDictionary*> *beacons = [@[] mutableCopy];
+        NSMutableArray<NSDictionary*> *beacons = [[NSMutableArray alloc] initWithCapacity:samples.count];
         
-        for(HLPBeaconSample* sample in _samples) {
+        for(HLPBeaconSample* sample in samples) {
             [beacons addObject:[sample toJSONByType:_type withInfo:nil]];
             info[@"x"] = @(sample.point.x);
             info[@"y"] = @(sample.point.y);
@@ -161,16 +191,98 @@
         [json addObject:obj];
     }
     if (_type == HLPBeaconSamplesRaw) {
-        for(HLPBeaconSample* sample in _samples) {
+        for(HLPBeaconSample* sample in samples) {
             [json addObject:[sample toJSONByType:_type withInfo:optionalInfo]];
         }        
     }
     return json;
 }
 
+#pragma mark - JSON writer
+
+static void appendString(NSMutableData *data, NSString *str)
+{
+    [data appendData:[str dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+static void appendObject(NSMutableData *data, NSObject *obj)
+{
+    [data appendData:[NSJSONSerialization dataWithJSONObject:obj options:0 error:nil]];
+}
+
+static NSDictionary* infoWithPoint(NSDictionary *optionalInfo, HLPPoint3D *point)
+{
+    NSMutableDictionary *info = [optionalInfo?optionalInfo:@{} mutableCopy];
+    info[@"x"] = @(point.x);
+    info[@"y"] = @(point.y);
+    return info;
+}
+
+// writes the same document as toJSON: without building a dictionary for each beacon
+- (NSData *)JSONData:(NSDictionary *)optionalInfo
+{
+    NSArray<HLPBeaconSample*> *samples = self.samples;
+    NSMutableData *data = [[NSMutableData alloc] initWithCapacity:samples.count * 512];
+    
+    if (_type == HLPBeaconSamplesBeacon) {
+        appendString(data, @"[{\"beacons\":[");
+        BOOL first = YES;
+        for(HLPBeaconSample* sample in samples) {
+            appendString(data, [NSString stringWithFormat:@"%@{\"timestamp\":%lld,", first?@"":@",", sample.timestamp]);
+            if (sample.uuidString) {
+                appendString(data, [NSString stringWithFormat:@"\"uuid\":\"%@\",", sample.uuidString]);
+            }
+            NSMutableString *beacons = [[NSMutableString alloc] initWithString:@"\"data\":["];
+            for(CLBeacon *b in sample.beacons) {
+                [beacons appendFormat:@"%@{\"major\":%@,\"minor\":%@,\"rssi\":%ld}",
+                 b == sample.beacons.firstObject?@"":@",", b.major, b.minor, (long)b.rssi];
+            }
+            [beacons appendString:@"]}"];
+            appendString(data, beacons);
+            first = NO;
+        }
+        appendString(data, @"],\"information\":");
+        appendObject(data, samples.count > 0 ? infoWithPoint(optionalInfo, samples.lastObject.point) : (optionalInfo?optionalInfo:@{}));
+        appendString(data, @"}]");
+    }
+    if (_type == HLPBeaconSamplesRaw) {
+        // beacon ids are formatted once per session
+        NSMutableDictionary<NSUUID*, NSMutableDictionary<NSNumber*, NSString*>*> *ids = [@{} mutableCopy];
+        
+        appendString(data, @"[");
+        BOOL first = YES;
+        for(HLPBeaconSample* sample in samples) {
+            appendString(data, first?@"{\"information\":":@",{\"information\":");
+            appendObject(data, infoWithPoint(optionalInfo, sample.point));
+            
+            NSMutableString *beacons = [[NSMutableString alloc] initWithString:@",\"data\":{\"beacons\":["];
+            for(CLBeacon *b in sample.beacons) {
+                NSMutableDictionary *idsForUUID = ids[b.proximityUUID];
+                if (!idsForUUID) {
+                    idsForUUID = ids[b.proximityUUID] = [@{} mutableCopy];
+                }
+                NSNumber *key = @((b.major.unsignedIntValue << 16) | b.minor.unsignedIntValue);
+                NSString *idString = idsForUUID[key];
+                if (!idString) {
+                    idString = idsForUUID[key] = [NSString stringWithFormat:@"%@-%@-%@", b.proximityUUID.UUIDString, b.major, b.minor];
+                }
+                [beacons appendFormat:@"%@{\"type\":\"iBeacon\",\"rssi\":%ld,\"id\":\"%@\",\"timestamp\":%lld}",
+                 b == sample.beacons.firstObject?@"":@",", (long)b.rssi, idString, sample.timestamp];
+            }
+            [beacons appendFormat:@"],\"timestamp\":%lld}}", sample.timestamp];
+            appendString(data, beacons);
+            first = NO;
+        }
+        appendString(data, @"]");
+    }
+    return data;
+}
+
 - (NSInteger)count
 {
-    return [_samples count];
+    @synchronized(self) {
+        return count;
+    }
 }
 
 @end
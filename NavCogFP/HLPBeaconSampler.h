@@ -67,6 +67,7 @@
 - (void) stopRecording;
 
 - (NSArray*) toJSON:(NSDictionary*)optionalInfo;
+- (NSData*) JSONData:(NSDictionary*)optionalInfo;
 - (long) visibleBeaconCount;
 - (long) beaconSampleCount;
 - (BOOL) isRecording;
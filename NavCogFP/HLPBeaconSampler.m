@@ -177,6 +177,10 @@ static HLPBeaconSampler *sharedData_ = nil;
     return [_samples toJSON:optionalInfo];
 }
 
+- (NSData *)JSONData:(NSDictionary*)optionalInfo {
+    return [_samples JSONData:optionalInfo];
+}
+
 - (long) beaconSampleCount {
     return [_samples count];
 }
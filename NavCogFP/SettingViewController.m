@@ -145,6 +145,7 @@ static HLPSetting *chooseConfig, *fingerprintLabel, *beaconUUID, *duration;
     duration = [userSettingHelper addSettingWithType:NavCogSettingTypeDouble Label:@"Duration" Name:@"finger_printing_duration" DefaultValue:@(5) Min:1 Max:30 Interval:1];
     
     [userSettingHelper addSettingWithType:NavCogSettingTypeBoolean Label:@"Show Route" Name:@"finger_printing_show_route" DefaultValue:@(NO) Accept:nil];
+    [userSettingHelper addSettingWithType:NavCogSettingTypeBoolean Label:@"Show Coverage" Name:@"finger_printing_show_coverage" DefaultValue:@(NO) Accept:nil];
     [userSettingHelper addSettingWithType:NavCogSettingTypeBoolean Label:@"Use HTTPS" Name:@"https_connection" DefaultValue:@(YES) Accept:nil];
     [[userSettingHelper addSettingWithType:NavCogSettingTypeTextInput Label:@"Context" Name:@"hokoukukan_server_context" DefaultValue:@"" Accept:nil] setVisible:NO];
 
@@ -24,6 +24,68 @@
 #import "ServerConfig+Preview.h"
 #import "NavDataStore.h"
 
+#define LOG_UPLOAD_CHUNK_SIZE (64*1024)
+
+// length of the bytes which does not end in the middle of a UTF-8 sequence
+static NSUInteger completeUTF8Length(const uint8_t *bytes, NSUInteger length)
+{
+    for(NSUInteger i = length; i > 0 && length - i < 4; i--) {
+        uint8_t b = bytes[i-1];
+        if ((b & 0xC0) == 0x80) {
+            continue;
+        }
+        NSUInteger need = (b & 0x80) == 0 ? 1 : (b & 0xE0) == 0xC0 ? 2 : (b & 0xF0) == 0xE0 ? 3 : (b & 0xF8) == 0xF0 ? 4 : 1;
+        return (i - 1 + need > length) ? i - 1 : length;
+    }
+    return length;
+}
+
+// writes the header dictionary with the log file content as "log" string into the path,
+// the log is read and escaped in chunks so that the whole log is never in memory
+static BOOL writeLogJSON(NSDictionary *header, NSString *logFile, NSString *path)
+{
+    NSFileHandle *input = [NSFileHandle fileHandleForReadingAtPath:logFile];
+    if (!input || ![[NSFileManager defaultManager] createFileAtPath:path contents:nil attributes:nil]) {
+        return NO;
+    }
+    NSFileHandle *output = [NSFileHandle fileHandleForWritingAtPath:path];
+    
+    NSData *headerData = [NSJSONSerialization dataWithJSONObject:header options:0 error:nil];
+    [output writeData:[headerData subdataWithRange:NSMakeRange(0, headerData.length-1)]];
+    [output writeData:[@",\"log\":\"" dataUsingEncoding:NSUTF8StringEncoding]];
+    
+    BOOL success = YES;
+    NSMutableData *pending = [[NSMutableData alloc] init];
+    while(success) {
+        @autoreleasepool {
+            NSData *data = [input readDataOfLength:LOG_UPLOAD_CHUNK_SIZE];
+            if (data.length == 0) {
+                break;
+            }
+            [pending appendData:data];
+            NSUInteger length = completeUTF8Length(pending.bytes, pending.length);
+            if (length == 0) {
+                continue;
+            }
+            NSString *str = [[NSString alloc] initWithBytes:pending.bytes length:length encoding:NSUTF8StringEncoding];
+            if (str == nil) {
+                success = NO;
+                break;
+            }
+            // ["..."] -> ...
+            NSData *escaped = [NSJSONSerialization dataWithJSONObject:@[str] options:0 error:nil];
+            [output writeData:[escaped subdataWithRange:NSMakeRange(2, escaped.length-4)]];
+            [pending replaceBytesInRange:NSMakeRange(0, length) withBytes:NULL length:0];
+        }
+    }
+    success = success && pending.length == 0;
+    
+    [output writeData:[@"\"}" dataUsingEncoding:NSUTF8StringEncoding]];
+    [output closeFile];
+    [input closeFile];
+    return success;
+}
+
 @implementation ExpConfig
 
 static ExpConfig *instance;
@@ -135,9 +197,8 @@ static ExpConfig *instance;
     
     NSString *logFileName = [logFile lastPathComponent];
     NSString *logFileId = [NSString stringWithFormat:@"%@/%@", _user_id, logFileName];
-    NSString *logContent = [NSString stringWithContentsOfFile:logFile encoding:NSUTF8StringEncoding error:&error];
     
-    if (logContent == nil) {
+    if (![[NSFileManager defaultManager] isReadableFileAtPath:logFile]) {
         NSLog(@"logContent is nil (%@)", logFile);
         complete();
         return;
@@ -227,20 +288,26 @@ static ExpConfig *instance;
     NSDictionary *logdic = @{
                               @"_id": logFileId,
                               @"user_id": _user_id,
-                              @"created_at": @(endAt),
-                              @"log": logContent
+                              @"created_at": @(endAt)
                               };
     
-    NSData *logdata = [NSJSONSerialization dataWithJSONObject:logdic options:0 error:&error];
+    NSString *logdataPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[logFileName stringByAppendingPathExtension:@"json"]];
+    if (!writeLogJSON(logdic, logFile, logdataPath)) {
+        NSLog(@"logContent is nil (%@)", logFile);
+        [[NSFileManager defaultManager] removeItemAtPath:logdataPath error:nil];
+        complete();
+        return;
+    }
     
     NSURL *userurl = [NSURL URLWithString:[NSString stringWithFormat:@"%@/user?id=%@",server, _user_id]];
     NSData *userdata = [NSJSONSerialization dataWithJSONObject:info options:0 error:&error];
     
     [HLPDataUtil postRequest:logurl
                  contentType:@"application/json; charset=UTF-8"
-                    withData:logdata
+                    withFile:logdataPath
                     callback:^(NSData *response)
      {
+         [[NSFileManager defaultManager] removeItemAtPath:logdataPath error:nil];
          NSError *error;
          [NSJSONSerialization JSONObjectWithData:response options:0 error:&error];
          if (error) {
@@ -23,7 +23,7 @@
 #import "HLPPreviewCommander.h"
 #import "HLPWalker.h"
 #import "NavDataStore.h"
-#import <FormatterKit/TTTOrdinalNumberFormatter.h>
+#import "NavStrings.h"
 
 @implementation HLPPreviewCommander {    
     BOOL stepLR;
@@ -326,7 +326,7 @@
         }
     }
     NSString *unit = isFeet?@"unit_feet":@"unit_meter";
-    return [NSString stringWithFormat:NSLocalizedStringFromTable(unit, @"BlindView", @""), (int)round(target)];
+    return [NSString stringWithFormat:NavLocalizedStringFromTable(unit, @"BlindView", @""), (int)round(target)];
 }
 
 
@@ -432,7 +432,7 @@
             }
             
             if(poi.poiCategory == HLPPOICategoryDoor) {
-                name = NSLocalizedStringFromTable(poi.flags.flagAuto?@"AutoDoorPOIString1": @"DoorPOIString1", @"BlindView", @"");
+                name = NavLocalizedStringFromTable(poi.flags.flagAuto?@"AutoDoorPOIString1": @"DoorPOIString1", @"BlindView", @"");
                 [str appendString:name];
                 continue;
             }
@@ -455,35 +455,30 @@
 
 - (NSString*) floorString:(double) floor
 {
-    NSString *type = NSLocalizedStringFromTable(@"FloorNumType", @"BlindView", @"floor num type");
+    NSString *type = NavLocalizedStringFromTable(@"FloorNumType", @"BlindView", @"floor num type");
     
     if ([type isEqualToString:@"ordinal"]) {
-        TTTOrdinalNumberFormatter*ordinalNumberFormatter = [[TTTOrdinalNumberFormatter alloc] init];
-        
         NSString *localeStr = [[NSUserDefaults standardUserDefaults] stringForKey:@"AppleLocale"];
-        NSLocale *locale = [NSLocale localeWithLocaleIdentifier:localeStr];
-        [ordinalNumberFormatter setLocale:locale];
-        [ordinalNumberFormatter setGrammaticalGender:TTTOrdinalNumberFormatterMaleGender];
         
         floor = round(floor*2.0)/2.0;
         
         
         if (floor < 0) {
-            NSString *ordinalNumber = [ordinalNumberFormatter stringFromNumber:@(fabs(floor))];
+            NSString *ordinalNumber = NavOrdinalNumberString(@(fabs(floor)), localeStr);
             
-            return [NSString localizedStringWithFormat:NSLocalizedStringFromTable(@"FloorBasementD", @"BlindView", @"basement floor"), ordinalNumber];
+            return [NSString localizedStringWithFormat:NavLocalizedStringFromTable(@"FloorBasementD", @"BlindView", @"basement floor"), ordinalNumber];
         } else {
-            NSString *ordinalNumber = [ordinalNumberFormatter stringFromNumber:@(floor+1)];
+            NSString *ordinalNumber = NavOrdinalNumberString(@(floor+1), localeStr);
             
-            return [NSString localizedStringWithFormat:NSLocalizedStringFromTable(@"FloorD", @"BlindView", @"floor"), ordinalNumber];
+            return [NSString localizedStringWithFormat:NavLocalizedStringFromTable(@"FloorD", @"BlindView", @"floor"), ordinalNumber];
         }
     } else {
         floor = round(floor*2.0)/2.0;
         
         if (floor < 0) {
-            return [NSString localizedStringWithFormat:NSLocalizedStringFromTable(@"FloorBasementD", @"BlindView", @"basement floor"), @(fabs(floor))];
+            return [NSString localizedStringWithFormat:NavLocalizedStringFromTable(@"FloorBasementD", @"BlindView", @"basement floor"), @(fabs(floor))];
         } else {
-            return [NSString localizedStringWithFormat:NSLocalizedStringFromTable(@"FloorD", @"BlindView", @"floor"), @(floor+1)];
+            return [NSString localizedStringWithFormat:NavLocalizedStringFromTable(@"FloorD", @"BlindView", @"floor"), @(floor+1)];
         }
     }
 }
@@ -50,13 +50,124 @@
 }
 @end
 
+// POIs of a link projected onto the link once and sorted by the distance from the source node,
+// so that the POIs around a location can be found by binary search
+@interface HLPPreviewLinkPois : NSObject
+@property (readonly) NSArray<HLPLocationObject*> *pois;
+@property (readonly) NSArray<HLPLocationObject*> *sortedPois;
+@property (readonly) NSArray<HLPLocationObject*> *reversedPois;
+- (instancetype) initWithLink:(HLPLink*)link pois:(NSArray<HLPLocationObject*>*)pois;
+- (HLPLocation*) projectedLocationOf:(HLPLocationObject*)poi;
+- (NSUInteger) indexOfPoi:(HLPLocationObject*)poi;
+- (NSRange) rangeOfPoisWithin:(double)distance from:(HLPLocation*)location;
+@end
+
+@implementation HLPPreviewLinkPois {
+    HLPLink *_link;
+    NSMapTable<HLPLocationObject*, HLPLocation*> *_projected;
+    NSMapTable<HLPLocationObject*, NSNumber*> *_index;
+    double *_offsets;
+}
+
+- (instancetype) initWithLink:(HLPLink*)link pois:(NSArray<HLPLocationObject*>*)pois
+{
+    self = [super init];
+    _link = link;
+    _pois = pois;
+    _projected = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+    _index = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+    
+    NSUInteger n = pois.count;
+    double *offsets = malloc(sizeof(double)*MAX(n, 1));
+    for(NSUInteger i = 0; i < n; i++) {
+        HLPLocation *l = [link nearestLocationTo:pois[i].location];
+        [_projected setObject:l forKey:pois[i]];
+        offsets[i] = [l distanceTo:link.sourceLocation];
+    }
+    NSMutableArray *order = [@[] mutableCopy];
+    for(NSUInteger i = 0; i < n; i++) {
+        [order addObject:@(i)];
+    }
+    [order sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSNumber *i1, NSNumber *i2) {
+        double diff = offsets[i1.unsignedIntegerValue] - offsets[i2.unsignedIntegerValue];
+        return diff < 0 ? NSOrderedAscending : diff > 0 ? NSOrderedDescending : NSOrderedSame;
+    }];
+    
+    NSMutableArray *sorted = [@[] mutableCopy];
+    _offsets = malloc(sizeof(double)*MAX(n, 1));
+    for(NSUInteger i = 0; i < n; i++) {
+        NSUInteger j = [order[i] unsignedIntegerValue];
+        [sorted addObject:pois[j]];
+        [_index setObject:@(i) forKey:pois[j]];
+        _offsets[i] = offsets[j];
+    }
+    free(offsets);
+    _sortedPois = sorted;
+    _reversedPois = sorted.reverseObjectEnumerator.allObjects;
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_offsets);
+}
+
+- (HLPLocation*) projectedLocationOf:(HLPLocationObject*)poi
+{
+    HLPLocation *l = [_projected objectForKey:poi];
+    return l ?: [_link nearestLocationTo:poi.location];
+}
+
+- (NSUInteger) indexOfPoi:(HLPLocationObject*)poi
+{
+    NSNumber *i = [_index objectForKey:poi];
+    return i ? i.unsignedIntegerValue : NSNotFound;
+}
+
+// a POI whose projection is within distance from location has its offset within distance
+// from the offset of location (triangle inequality), so the range is a superset of such POIs
+- (NSRange) rangeOfPoisWithin:(double)distance from:(HLPLocation*)location
+{
+    double offset = [location distanceTo:_link.sourceLocation];
+    NSUInteger n = _sortedPois.count;
+    NSUInteger lo = 0, hi = n;
+    while(lo < hi) {
+        NSUInteger mid = (lo + hi) / 2;
+        if (_offsets[mid] < offset - distance) lo = mid + 1; else hi = mid;
+    }
+    NSUInteger start = lo;
+    hi = n;
+    while(lo < hi) {
+        NSUInteger mid = (lo + hi) / 2;
+        if (_offsets[mid] <= offset + distance) lo = mid + 1; else hi = mid;
+    }
+    return NSMakeRange(start, lo - start);
+}
+@end
+
+@interface HLPPreviewer ()
+- (HLPPreviewLinkPois*) linkPoisFor:(HLPLink*)link;
+@end
+
 @implementation HLPPreviewEvent {
     HLPLocation *_location;
     NSArray *_linkPoisCache;
+    HLPPreviewLinkPois *_linkPoisIndex;
+    HLPLink *_linkPoisIndexLink;
     HLPPreviewer *_previewer;
     BOOL _isSteppingBackward;
+    
+    // next event is computed once and shared by unchanged clones of this event;
+    // only clones of the cached event are returned so callers can modify them
+    HLPPreviewEvent *_nextCache;
+    BOOL _nextCacheAutoProceed;
+    long _nextCacheGeneration;
+    HLPPreviewEvent *_origin;
 }
 
+// incremented when user defaults change, which may change effective POIs (see isEffective:)
+static long nextCacheGeneration = 0;
+
 typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     HLPPreviewHeadingTypeForward = 0,
     HLPPreviewHeadingTypeBackward,
@@ -88,6 +199,39 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     return temp;
 }
 
+// identical copy without recomputing the state, shares the next event cache with this event
+- (HLPPreviewEvent*) _clone
+{
+    HLPPreviewEvent *temp = [self _copyState];
+    temp->_origin = _origin ?: self;
+    return temp;
+}
+
+// identical copy without recomputing the state and without the next event cache
+- (HLPPreviewEvent*) _copyState
+{
+    HLPPreviewEvent *temp = [[[self class] alloc] init];
+    temp->_previewer = _previewer;
+    temp->_link = _link;
+    temp->_routeLink = _routeLink;
+    temp->_location = _location;
+    temp->_orientation = _orientation;
+    temp->_turnedAngle = _turnedAngle;
+    temp->_distanceMoved = _distanceMoved;
+    temp->_prev = _prev;
+    temp->_isSteppingBackward = _isSteppingBackward;
+    temp->_linkPoisCache = _linkPoisCache;
+    temp->_linkPoisIndex = _linkPoisIndex;
+    temp->_linkPoisIndexLink = _linkPoisIndexLink;
+    return temp;
+}
+
+- (void) _invalidateNext
+{
+    _nextCache = nil;
+    _origin = nil;
+}
+
 - (instancetype)initForPreviewer:(HLPPreviewer*)previewer withLink:(HLPLink *)link Location:(HLPLocation*)location Orientation:(double)orientation onRoute:(HLPLink*)routeLink
 {
     self = [super init];
@@ -100,42 +244,73 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     return self;
 }
 
+- (HLPPreviewLinkPois*) _linkPoisIndex
+{
+    if (!_linkPoisIndex || _linkPoisIndexLink != _link) {
+        _linkPoisIndexLink = _link;
+        if (_previewer) {
+            _linkPoisIndex = [_previewer linkPoisFor:_link];
+        } else {
+            NSArray *pois = [[NavDataStore sharedDataStore] poisForLink:_link];
+            _linkPoisIndex = pois ? [[HLPPreviewLinkPois alloc] initWithLink:_link pois:pois] : nil;
+        }
+    }
+    return _linkPoisIndex;
+}
+
+// POIs of the link in walking order
 - (NSArray*) _linkPois
 {
     if (!_linkPoisCache) {
-        NSArray *temp = [NavDataStore sharedDataStore].linkPoiMap[_link._id];
-        if (temp) {
-            temp = [temp sortedArrayUsingComparator:^NSComparisonResult(HLPPOI *poi1, HLPPOI *poi2) {
-                HLPLocation *l1 = [_link nearestLocationTo:poi1.location];
-                HLPLocation *l2 = [_link nearestLocationTo:poi2.location];
-                double diff = [l1 distanceTo:_link.sourceLocation] - [l2 distanceTo:_link.sourceLocation];
-                
-                if (self._sourceToTarget) {
-                    return diff < 0 ? NSOrderedAscending : NSOrderedDescending;
-                }
-                else if (self._targetToSource) {
-                    return diff > 0 ? NSOrderedAscending : NSOrderedDescending;
-                }
-                return NSOrderedSame;
-            }];
-
-            /*
-            [temp enumerateObjectsUsingBlock:^(HLPPOI *poi, NSUInteger idx, BOOL * _Nonnull stop) {
-                HLPLocation *l = [_link nearestLocationTo:poi.location];
-                double dist = [l distanceTo:self._sourceToTarget?_link.sourceLocation:_link.targetLocation];
-                NSLog(@"%@ %.2f", poi._id, dist);
-            }];
-             */
+        HLPPreviewLinkPois *lp = self._linkPoisIndex;
+        if (self._sourceToTarget) {
+            _linkPoisCache = lp.sortedPois;
+        }
+        else if (self._targetToSource) {
+            _linkPoisCache = lp.reversedPois;
+        }
+        else {
+            _linkPoisCache = lp.pois;
         }
-        _linkPoisCache = temp;
     }
     return _linkPoisCache;
 }
 
+- (HLPLocation*) _projectedLocationOf:(HLPLocationObject*)lo
+{
+    HLPPreviewLinkPois *lp = self._linkPoisIndex;
+    return lp ? [lp projectedLocationOf:lo] : [_link nearestLocationTo:lo.location];
+}
+
+// POIs of the link whose projection is within distance from the current location, in walking order
+- (NSArray<HLPLocationObject*>*) _linkPoisWithin:(double)distance
+{
+    NSArray *pois = self._linkPois;
+    if (pois == nil) {
+        return nil;
+    }
+    NSArray *candidates = pois;
+    if (self._sourceToTarget || self._targetToSource) {
+        HLPPreviewLinkPois *lp = self._linkPoisIndex;
+        candidates = [lp.sortedPois subarrayWithRange:[lp rangeOfPoisWithin:distance from:_location]];
+        if (self._targetToSource) {
+            candidates = candidates.reverseObjectEnumerator.allObjects;
+        }
+    }
+    NSMutableArray *temp = [@[] mutableCopy];
+    for(HLPLocationObject *lo in candidates) {
+        if ([[self _projectedLocationOf:lo] distanceTo:_location] < distance) {
+            [temp addObject:lo];
+        }
+    }
+    return temp;
+}
+
 - (void)setLocation:(HLPLocation *)location
 {
     _location = location;
     _linkPoisCache = nil; // clear cache
+    [self _invalidateNext];
 
     if (_link == nil) {
         return;
@@ -410,25 +585,39 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
         } else if (self._targetToSource) {
             next = _link.sourceNode;
         }
+    } else if (self._sourceToTarget || self._targetToSource) {
+        // walking order is [first node, POIs..., last node]; the step target is the one
+        // after the furthest one within 0.5m from the current location
+        NSArray<HLPLocationObject*> *pois = self._linkPois;
+        if (pois == nil) pois = @[];
+        HLPNode *first = self._sourceToTarget ? _link.sourceNode : _link.targetNode;
+        HLPNode *last = self._sourceToTarget ? _link.targetNode : _link.sourceNode;
+        
+        HLPLocationObject *passed = nil;
+        if ([[self _projectedLocationOf:last] distanceTo:_location] < 0.5) {
+            next = last;
+        } else if ((passed = [[self _linkPoisWithin:0.5] lastObject])) {
+            NSUInteger i = [self._linkPoisIndex indexOfPoi:passed];
+            if (self._targetToSource) {
+                i = pois.count - 1 - i;
+            }
+            next = (i+1 < pois.count) ? pois[i+1] : last;
+        } else if ([[self _projectedLocationOf:first] distanceTo:_location] < 0.5) {
+            next = (pois.count > 0) ? pois[0] : last;
+        } else {
+            next = first;
+        }
     } else {
         NSArray<HLPLocationObject*> *stepTargets = self._linkPois;
         if (stepTargets == nil) stepTargets = @[];
         
-        if (self._sourceToTarget) {
-            stepTargets = [@[_link.sourceNode] arrayByAddingObjectsFromArray:stepTargets];
-            stepTargets = [stepTargets arrayByAddingObject:_link.targetNode];
-        } else if (self._targetToSource) {
-            stepTargets = [@[_link.targetNode] arrayByAddingObjectsFromArray:stepTargets];
-            stepTargets = [stepTargets arrayByAddingObject:_link.sourceNode];
-        }
-        
         unsigned long j = 0;
         for(unsigned long i = 0; i < stepTargets.count; i++) {
             HLPLocationObject *lo = stepTargets[i];
             if (![lo isKindOfClass:HLPLocationObject.class]) {
                 continue;
             }
-            if ([[_link nearestLocationTo:lo.location] distanceTo:_location] < 0.5) {
+            if ([[self _projectedLocationOf:lo] distanceTo:_location] < 0.5) {
                 j = MIN((i+1), stepTargets.count-1);
             }
         }
@@ -450,7 +639,7 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
 
 - (HLPLocation*)stepTargetLocation
 {
-    return [_link nearestLocationTo:self.stepTarget.location];
+    return [self _projectedLocationOf:self.stepTarget];
 }
 
 - (double)distanceToStepTarget
@@ -465,9 +654,37 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
 - (void) setPrev:(HLPPreviewEvent *)prev
 {
     _prev = prev;
+    [self _invalidateNext];
 }
 
 - (HLPPreviewEvent *)next
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        [[NSNotificationCenter defaultCenter] addObserverForName:NSUserDefaultsDidChangeNotification object:nil queue:nil usingBlock:^(NSNotification * _Nonnull note) {
+            nextCacheGeneration++;
+        }];
+    });
+    
+    HLPPreviewEvent *owner = _origin ?: self;
+    BOOL autoProceed = _previewer.isAutoProceed; // affects effective POIs
+    if (!owner->_nextCache ||
+        owner->_nextCacheAutoProceed != autoProceed ||
+        owner->_nextCacheGeneration != nextCacheGeneration) {
+        // step from a copy so that the prev chain of the cached event does not lead back to the owner
+        HLPPreviewEvent *start = [self _copyState];
+        HLPPreviewEvent *next = [start _next];
+        if (next == start) {
+            return self; // cannot step forward, nothing to cache
+        }
+        owner->_nextCache = next;
+        owner->_nextCacheAutoProceed = autoProceed;
+        owner->_nextCacheGeneration = nextCacheGeneration;
+    }
+    return [owner->_nextCache _clone];
+}
+
+- (HLPPreviewEvent *)_next
 {
     HLPPreviewEvent *temp = self;
     HLPLocationObject *prevTarget = nil;
@@ -605,16 +822,7 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     if ([_link.targetNode.location distanceTo:_location] < 0.5) {
         return _link.targetNode;
     }
-    NSArray *pois = self._linkPois;
-    if (pois) {
-        for(HLPLocationObject *lo in pois) {
-            if ([[_link nearestLocationTo:lo.location] distanceTo:_location] < 0.01) {
-                return lo;
-            }
-        }
-    }
-    
-    return nil;
+    return [[self _linkPoisWithin:0.01] firstObject];
 }
 
 - (HLPNode*)  targetNode
@@ -696,11 +904,9 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     }
     
     NSMutableArray *temp = [@[] mutableCopy];
-    for(HLPLocationObject *obj in self._linkPois) {
-        if ([[_link nearestLocationTo:obj.location] distanceTo:_location] < 0.5) {
-            if ([self isEffective:obj]) {
-                [temp addObject:obj];
-            }
+    for(HLPLocationObject *obj in [self _linkPoisWithin:0.5]) {
+        if ([self isEffective:obj]) {
+            [temp addObject:obj];
         }
     }
     if ([temp count] > 0) {
@@ -716,12 +922,10 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     }
     
     NSMutableArray *temp = [@[] mutableCopy];
-    for(HLPLocationObject *obj in self._linkPois) {
+    for(HLPLocationObject *obj in [self _linkPoisWithin:0.5]) {
         if ([obj isKindOfClass:HLPEntrance.class]) {
-            if ([[_link nearestLocationTo:obj.location] distanceTo:_location] < 0.5) {
-                if ([self isEffective:obj]) {
-                    [temp addObject:obj];
-                }
+            if ([self isEffective:obj]) {
+                [temp addObject:obj];
             }
         }
     }
@@ -740,7 +944,7 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
         }
         HLPPOI *poi = (HLPPOI*)obj;
         if (poi.poiCategory == HLPPOICategoryCornerEnd || poi.poiCategory == HLPPOICategoryCornerLandmark) {
-            if ([[_link nearestLocationTo:obj.location] distanceTo:_location] < 3 &&
+            if ([[self _projectedLocationOf:obj] distanceTo:_location] < 3 &&
                 [poi isOnFront:self.location]) {
                 return poi;
             }
@@ -755,7 +959,7 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     NSArray *links = nds.nodeLinksMap[self.targetNode._id];
     for(HLPLink* link in links) {
         if (link.linkType == LINK_TYPE_ELEVATOR) {
-            NSArray *pois = nds.linkPoiMap[link._id];
+            NSArray *pois = [nds poisForLink:link];
             for(HLPPOI *poi in pois) {
                 if (poi.poiCategory == HLPPOICategoryElevator) {
                     return poi;
@@ -772,7 +976,7 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     NSArray *links = nds.nodeLinksMap[self.targetNode._id];
     for(HLPLink* link in links) {
         if (link.linkType == LINK_TYPE_ELEVATOR) {
-            NSArray *pois = nds.linkPoiMap[link._id];
+            NSArray *pois = [nds poisForLink:link];
             for(HLPPOI *poi in pois) {
                 if (poi.poiCategory == HLPPOICategoryElevatorEquipments) {
                     return poi;
@@ -916,11 +1120,14 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     NSArray *route;
     
     NSTimer *autoTimer;
+    BOOL isAutoStepping;
+    NSTimeInterval stepCounterUpdated;
     double stepSpeed;
     double stepCounter;
     double remainingDistanceToNextStep;
     double remainingDistanceToNextAction;
     HLPLocation *currentLocation;
+    NSMapTable<HLPLink*, HLPPreviewLinkPois*> *linkPoisCache;
 }
 
 - (instancetype) init
@@ -936,10 +1143,38 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     return current;
 }
 
+- (HLPPreviewLinkPois*) linkPoisFor:(HLPLink*)link
+{
+    if (link == nil) {
+        return nil;
+    }
+    @synchronized(self) {
+        if (!linkPoisCache) {
+            // keyed by instance, route links can be reversed copies of the links with the same id.
+            // the values hold their link, so keys are strong and the table is cleared in startAt:
+            linkPoisCache = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                                  valueOptions:NSPointerFunctionsStrongMemory];
+        }
+        HLPPreviewLinkPois *lp = [linkPoisCache objectForKey:link];
+        if (!lp) {
+            NSArray *pois = [[NavDataStore sharedDataStore] poisForLink:link];
+            if (pois == nil) {
+                return nil;
+            }
+            lp = [[HLPPreviewLinkPois alloc] initWithLink:link pois:pois];
+            [linkPoisCache setObject:lp forKey:link];
+        }
+        return lp;
+    }
+}
+
 - (void)startAt:(HLPLocation *)loc
 {
     nds = [NavDataStore sharedDataStore];
     route = nds.route;
+    @synchronized(self) {
+        linkPoisCache = nil;
+    }
     
     //find nearest link
     double min = DBL_MAX;
@@ -1252,7 +1487,9 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
 {
     NSLog(@"%@,%f", NSStringFromSelector(_cmd), NSDate.date.timeIntervalSince1970);
     if (_isAutoProceed) {
+        [self _updateStepCounter];
         stepSpeed = MIN(stepSpeed * SPEED_FACTOR, MAX_SPEED);
+        [self _scheduleAutoStep];
         return;
     }
     [self _autoStepStart];
@@ -1260,9 +1497,9 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
 
 - (void)_autoStepStart
 {
-    if (!autoTimer) {
+    if (!isAutoStepping) {
         stepCounter = 1;
-        autoTimer = [NSTimer scheduledTimerWithTimeInterval:TIMER_INTERVAL target:self selector:@selector(autoStep:) userInfo:nil repeats:YES];
+        isAutoStepping = YES;
     }
     
     _isAutoProceed = YES;
@@ -1270,11 +1507,13 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     
     remainingDistanceToNextStep = current.next.distanceMoved;
     remainingDistanceToNextAction = current.nextAction.distanceMoved;
+    [self _scheduleAutoStep];
 }
 
 - (void)_autoStepPause
 {
     if (_isAutoProceed) {
+        [self _updateStepCounter];
         _isAutoProceed = NO;
         _isWaitingAction = YES;
     } else {
@@ -1297,13 +1536,16 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
 {
     _isAutoProceed = NO;
     _isWaitingAction = NO;
+    [self _scheduleAutoStep];
 }
 
 - (void)autoStepForwardDown
 {
     NSLog(@"%@,%f", NSStringFromSelector(_cmd), NSDate.date.timeIntervalSince1970);
     if (_isAutoProceed) {
+        [self _updateStepCounter];
         stepSpeed = MAX(stepSpeed / SPEED_FACTOR, MIN_SPEED);
+        [self _scheduleAutoStep];
     }
 }
 
@@ -1321,18 +1563,42 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
     
 }
 
-- (void)autoStep:(NSTimer*)timer
+// the step counter advances by stepSpeed per second and a step is taken each time it reaches 1,
+// so the timer is scheduled once for the time the next step happens instead of ticking continuously
+- (void)_updateStepCounter
 {
-    if (_isWaitingAction) {
+    NSTimeInterval now = [[NSDate date] timeIntervalSince1970];
+    if (autoTimer) {
+        stepCounter += (now - stepCounterUpdated) * stepSpeed;
+    }
+    stepCounterUpdated = now;
+}
+
+- (void)_scheduleAutoStep
+{
+    [autoTimer invalidate];
+    autoTimer = nil;
+    if (!_isAutoProceed) {
+        if (!_isWaitingAction) {
+            isAutoStepping = NO;
+        }
         return;
     }
-    if (_isAutoProceed == NO) {
-        [autoTimer invalidate];
-        autoTimer = nil;
+    stepCounterUpdated = [[NSDate date] timeIntervalSince1970];
+    double delay = MAX(TIMER_INTERVAL, (1.0 - stepCounter) / stepSpeed);
+    autoTimer = [NSTimer scheduledTimerWithTimeInterval:delay target:self selector:@selector(autoStep:) userInfo:nil repeats:NO];
+}
+
+- (void)autoStep:(NSTimer*)timer
+{
+    if (!_isAutoProceed) {
+        [self _scheduleAutoStep];
+        return;
     }
+    [self _updateStepCounter];
+    autoTimer = nil;
     
-    stepCounter += TIMER_INTERVAL * stepSpeed;
-    if (stepCounter >= 1.0) {
+    if (stepCounter >= 1.0 - 1e-6) {
         double step_length = [[NSUserDefaults standardUserDefaults] doubleForKey:@"preview_step_length"];
         
         dispatch_async(dispatch_get_main_queue(), ^{
@@ -1341,7 +1607,7 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
                 [self fireUserLocation:currentLocation];
             }
         });
-        stepCounter -= 1.0;
+        stepCounter = MAX(0, stepCounter - 1.0);
         
         if (_isAutoProceed) {            
             remainingDistanceToNextStep -= step_length;
@@ -1354,6 +1620,7 @@ typedef NS_ENUM(NSUInteger, HLPPreviewHeadingType) {
             }
         }
     }
+    [self _scheduleAutoStep];
 }
 
 @end
@@ -24,8 +24,8 @@
 #import "HLPGeoJSON.h"
 
 @interface HLPWalkerPointer:NSObject
-@property HLPNode* node;
-@property HLPLink* link;
+@property (nonatomic, readonly) HLPNode* node;
+@property (nonatomic, readonly) HLPLink* link;
 
 - (instancetype)initWithNode:(HLPNode*)node Link:(HLPLink*)link;
 - (NSSet<HLPWalkerPointer*>*)walk;
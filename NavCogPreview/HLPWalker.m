@@ -23,7 +23,9 @@
 #import "HLPWalker.h"
 #import "NavDataStore.h"
 
-@implementation HLPWalkerPointer
+@implementation HLPWalkerPointer {
+    NSUInteger _hash;
+}
 
 - (instancetype)initWithNode:(HLPNode *)node Link:(HLPLink *)link
 {
@@ -41,6 +43,9 @@
 
 - (BOOL)isEqual:(id)object
 {
+    if (object == self) {
+        return YES;
+    }
     if ([object isKindOfClass:HLPWalkerPointer.class]) {
         HLPWalkerPointer* p = ((HLPWalkerPointer*)object);
         return [p.node._id isEqualToString:_node._id] && [p.link._id isEqualToString:_link._id];
@@ -48,10 +53,16 @@
     return NO;
 }
 
+// visited checks call hash for every pointer, so it is combined from the ids once
 - (NSUInteger)hash
 {
-    NSString *str = [NSString stringWithFormat:@"%@_%@", _node._id, _link._id];
-    return str.hash;
+    if (_hash == 0) {
+        _hash = (_node._id.hash * 31) ^ _link._id.hash;
+        if (_hash == 0) {
+            _hash = 1;
+        }
+    }
+    return _hash;
 }
 
 
@@ -66,21 +77,20 @@
     
     NSArray *links = [NavDataStore sharedDataStore].nodeLinksMap[next._id];
     
-    links = [links filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(HLPLink *link, NSDictionary<NSString *,id> * _Nullable bindings) {
+    NSMutableSet *temp = [[NSMutableSet alloc] initWithCapacity:links.count];
+    for(HLPLink* link in links) {
         if (link == _link) {
-            return NO;
+            continue;
         }
         if (link.direction == DIRECTION_TYPE_SOURCE_TO_TARGET) {
-            return (link.sourceNode == next);
+            if (link.sourceNode != next) continue;
         }
-        if (link.direction == DIRECTION_TYPE_TARGET_TO_SOURCE) {
-            return (link.targetNode == next);
+        else if (link.direction == DIRECTION_TYPE_TARGET_TO_SOURCE) {
+            if (link.targetNode != next) continue;
+        }
+        else if (link.isLeaf) {
+            continue;
         }
-        return !link.isLeaf;
-    }]];
-    
-    NSMutableSet *temp = [[NSMutableSet alloc] init];
-    for(HLPLink* link in links) {
         [temp addObject:[[HLPWalkerPointer alloc] initWithNode:next Link:link]];
     }
 
@@ -94,6 +104,7 @@
     NSMutableSet* visited;
     HLPWalkerPointer *_root;
     double _rootOri;
+    NSMutableDictionary<NSString*, NSNumber*> *bearingCache; // bearing from root by node id
 }
 
 static HLPWalker *instance;
@@ -110,12 +121,14 @@ static HLPWalker *instance;
 {
     current = [[NSMutableSet alloc] init];
     visited = [[NSMutableSet alloc] init];
+    bearingCache = [[NSMutableDictionary alloc] init];
     _root = nil;
 }
 
 - (void) setRoot:(HLPWalkerPointer *)root
 {
     _root = root;
+    [bearingCache removeAllObjects];
     
     if (root.link.sourceNode == root.node) {
         _rootOri = root.link.initialBearingFromSource;
@@ -135,7 +148,14 @@ static HLPWalker *instance;
         for(HLPWalkerPointer *p2 in ps) {
             if ([visited containsObject:p2] == NO) {
                 if (_angle > 0) {
-                    double o = [_root.node.location bearingTo:p2.node.location];
+                    NSNumber *bearing = bearingCache[p2.node._id];
+                    if (bearing == nil) {
+                        bearing = @([_root.node.location bearingTo:p2.node.location]);
+                        if (p2.node._id) {
+                            bearingCache[p2.node._id] = bearing;
+                        }
+                    }
+                    double o = bearing.doubleValue;
                     if (fabs([HLPLocation normalizeDegree:o-_rootOri]) > _angle) {
                         continue;
                     }